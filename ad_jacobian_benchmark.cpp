@@ -0,0 +1,184 @@
+/*
+####Title:
+Benchmark: Single-Sweep Automatic Differentiation Jacobian
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+Compares two ways of getting F(x) and the Jacobian of the paraboloid system from automatic_differentiation.cpp:
+
+1)"calculateJacobianPerColumn" re-evaluates the model once before the column loop and once more for every column,
+reading only column j of the derivatives on each pass. This costs NUMDIMENSIONS+1 model evaluations.
+2)"calculateJacobian" evaluates the model once; forward AD has already propagated the derivatives with respect to
+every independent variable, so F(x) and every column are read from that single evaluation.
+
+automatic_differentiation.cpp goes one step further than 2): its single evaluation is the one of F(x) at the end of
+the previous iteration, so its "calculateJacobian" only reads the derivatives and costs no evaluation of its own.
+The single evaluation timed here is that end-of-iteration evaluation, so both methods deliver F(x) and the Jacobian.
+
+Both Jacobians are checked against each other, then each method is timed over REPETITIONS Jacobians.
+Model evaluations are counted by "countingCalculateDependentVariables", which is handed to both methods as a plain
+function pointer; the example itself passes its model as a function object templated on the scalar type.
+
+####Dependencies:
+Same as automatic_differentiation.cpp: Armadillo, and Trilinos with the Teuchos and Sacado packages.
+The timing uses std::chrono, so compile with -std=c++11.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <Teuchos_RCPNode.hpp>
+#include <Sacado.hpp>
+#include <armadillo>
+#include <valarray>
+
+typedef Sacado::Fad::DFad<double>  F;  // Forward AD with # of ind. vars given later
+
+const int NUMDIMENSIONS = 3;
+const int REPETITIONS = 100000;
+
+//Number of model evaluations since it was last reset
+long modelEvaluations = 0;
+
+void calculateDependentVariables(const std::valarray<F>& myOffsets,
+				 const std::valarray<F>& myCurrentGuess,
+				 std::valarray<F>& targetsCalculated);
+
+void countingCalculateDependentVariables(const std::valarray<F>& myOffsets,
+					 const std::valarray<F>& myCurrentGuess,
+					 std::valarray<F>& targetsCalculated);
+
+void calculateJacobianPerColumn(const std::valarray<F>& myOffsets,
+				arma::Mat<double>& myJacobian,
+				std::valarray<F>& myTargetsCalculated,
+				std::valarray<F>& myCurrentGuess,
+				void myCalculateDependentVariables(const std::valarray<F>&, const std::valarray<F>&, std::valarray<F>&));
+
+void calculateJacobian(const std::valarray<F>& myOffsets,
+		       arma::Mat<double>& myJacobian,
+		       std::valarray<F>& myTargetsCalculated,
+		       std::valarray<F>& myCurrentGuess,
+		       void myCalculateDependentVariables(const std::valarray<F>&, const std::valarray<F>&, std::valarray<F>&));
+
+int main(int argc, char* argv[])
+{
+	void (*yourCalculateDependentVariables)(const std::valarray<F>&, const std::valarray<F>&, std::valarray<F>&);
+	yourCalculateDependentVariables = &countingCalculateDependentVariables;
+
+	//Same problem and starting point as automatic_differentiation.cpp
+	std::valarray<F> offsets(0.0, NUMDIMENSIONS*NUMDIMENSIONS);
+	offsets[0] = 1.0;
+	offsets[2*NUMDIMENSIONS -1] = 1.0;
+	offsets[3*NUMDIMENSIONS -1] = 1.0;
+
+	std::valarray<F> targetsCalculated(0.0, NUMDIMENSIONS);
+
+	std::valarray<F> currentGuess(2.0, NUMDIMENSIONS);
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		currentGuess[i].diff(i, NUMDIMENSIONS);
+	}
+
+	arma::Mat<double> perColumnJacobian(NUMDIMENSIONS, NUMDIMENSIONS);
+	perColumnJacobian.fill(0.0);
+	arma::Mat<double> singleSweepJacobian(NUMDIMENSIONS, NUMDIMENSIONS);
+	singleSweepJacobian.fill(0.0);
+
+	//Both methods must produce the same Jacobian
+	calculateJacobianPerColumn(offsets, perColumnJacobian, targetsCalculated, currentGuess, yourCalculateDependentVariables);
+	calculateJacobian(offsets, singleSweepJacobian, targetsCalculated, currentGuess, yourCalculateDependentVariables);
+	std::cout << "Running single-sweep AD Jacobian benchmark ................" << std::endl;
+	std::cout << "Largest difference between the two Jacobians: "
+		  << arma::abs(perColumnJacobian - singleSweepJacobian).max() << std::endl;
+
+	modelEvaluations = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(int r = 0; r < REPETITIONS; r++)
+	{
+		calculateJacobianPerColumn(offsets, perColumnJacobian, targetsCalculated, currentGuess, yourCalculateDependentVariables);
+	}
+	double perColumnSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	long perColumnEvaluations = modelEvaluations;
+
+	modelEvaluations = 0;
+	start = std::chrono::steady_clock::now();
+	for(int r = 0; r < REPETITIONS; r++)
+	{
+		calculateJacobian(offsets, singleSweepJacobian, targetsCalculated, currentGuess, yourCalculateDependentVariables);
+	}
+	double singleSweepSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	long singleSweepEvaluations = modelEvaluations;
+
+	std::cout << "******************************************" << std::endl;
+	std::cout << "Jacobians per method: " << REPETITIONS << std::endl;
+	std::cout << "Per-column:   " << double(perColumnEvaluations)/REPETITIONS << " model evaluations per Jacobian, "
+		  << 1.0E6*perColumnSeconds/REPETITIONS << " microseconds per Jacobian" << std::endl;
+	std::cout << "Single-sweep: " << double(singleSweepEvaluations)/REPETITIONS << " model evaluations per Jacobian, "
+		  << 1.0E6*singleSweepSeconds/REPETITIONS << " microseconds per Jacobian" << std::endl;
+	std::cout << "Speedup: " << perColumnSeconds/singleSweepSeconds << std::endl;
+	std::cout << "--program complete--" << std::endl;
+
+	return 0;
+}
+
+
+//This function is specific to a single problem
+void calculateDependentVariables(const std::valarray<F>& myOffsets,
+				 const std::valarray<F>& myCurrentGuess,
+				 std::valarray<F>& targetsCalculated)
+{
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		targetsCalculated[i] = pow(myCurrentGuess[std::slice(0,2,1)] - myOffsets[std::slice(i*NUMDIMENSIONS, 2, 1)],2.0).sum();
+		targetsCalculated[i] = targetsCalculated[i] + myCurrentGuess[2]*pow(-1.0, i) - myOffsets[i*NUMDIMENSIONS + 2];
+	}
+}
+
+void countingCalculateDependentVariables(const std::valarray<F>& myOffsets,
+					 const std::valarray<F>& myCurrentGuess,
+					 std::valarray<F>& targetsCalculated)
+{
+	modelEvaluations++;
+	calculateDependentVariables(myOffsets, myCurrentGuess, targetsCalculated);
+}
+
+void calculateJacobianPerColumn(const std::valarray<F>& myOffsets,
+				arma::Mat<double>& myJacobian,
+				std::valarray<F>& myTargetsCalculated,
+				std::valarray<F>& myCurrentGuess,
+				void myCalculateDependentVariables(const std::valarray<F>&, const std::valarray<F>&, std::valarray<F>&))
+{
+	//The previous form of calculateJacobian from automatic_differentiation.cpp
+	myCalculateDependentVariables(myOffsets, myCurrentGuess, myTargetsCalculated);
+
+	for(int j = 0; j< NUMDIMENSIONS; j++)
+	{
+		myCalculateDependentVariables(myOffsets, myCurrentGuess, myTargetsCalculated);
+
+		for(int i = 0; i < NUMDIMENSIONS; i++)
+		{
+			myJacobian.col(j)[i] = myTargetsCalculated[i].dx(j);
+		}
+	}
+}
+
+void calculateJacobian(const std::valarray<F>& myOffsets,
+		       arma::Mat<double>& myJacobian,
+		       std::valarray<F>& myTargetsCalculated,
+		       std::valarray<F>& myCurrentGuess,
+		       void myCalculateDependentVariables(const std::valarray<F>&, const std::valarray<F>&, std::valarray<F>&))
+{
+	//One evaluation for F(x) and the whole Jacobian; automatic_differentiation.cpp makes it at the end of the
+	//previous iteration and its calculateJacobian only reads the derivatives below
+	myCalculateDependentVariables(myOffsets, myCurrentGuess, myTargetsCalculated);
+
+	for(int j = 0; j< NUMDIMENSIONS; j++)
+	{
+		for(int i = 0; i < NUMDIMENSIONS; i++)
+		{
+			myJacobian.col(j)[i] = myTargetsCalculated[i].dx(j);
+		}
+	}
+}
+
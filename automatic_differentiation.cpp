@@ -21,11 +21,42 @@ x^2 + y^2 +(z-1) = 0
 
 They should intersect at the point (1, 0, 0)
 
-The method "calculateDependentVariables" is specific to this problem, however everything else is largely general.
+The model "ParaboloidModel" is specific to this problem, however everything else is largely general.
+It is a function object that carries the offsets of the paraboloids and whose operator() is templated on the scalar
+type, so the same model object is evaluated with FadType for the Jacobian and with DirectionalF for the
+Jacobian-free products. The functions that need the model take its type as a template parameter rather than a
+function pointer, so the compiler can inline it.
 
-The method "calculateJacobian" demonstrates the use of the forward automatic differentiation technique:
+The forward automatic differentiation technique takes two steps:
 1)Model evalution is computed, where special datatypes are used for independent and dependent variables 
-2)Stored partial derivatives are accessed and the jacobian is populated
+2)"calculateJacobian" accesses the stored partial derivatives and populates the jacobian
+A single forward pass carries the derivatives with respect to every independent variable at once,
+so the whole Jacobian and the unperturbed values both come from one model evaluation.
+Step 1 is the evaluation of F(x) at the updated guess at the end of every iteration (and at the initial guess
+before the loop), so the next iteration's Jacobian is read from it and each iteration costs one model evaluation.
+See ad_jacobian_benchmark.cpp for a comparison against re-evaluating the model for every column.
+
+The example is templated on the forward AD type, selected in main by ADTYPE:
+-Sacado::Fad::DFad<double> stores its derivative array on the heap, sized when diff() is called. It is the one to use
+when the number of independent variables is only known at runtime, but every temporary in the model allocates.
+-Sacado::Fad::SFad<double, NUMDIMENSIONS> fixes the size of the derivative array at compile time. Nothing is
+allocated while the model is evaluated and the compiler can unroll and vectorize the derivative loops.
+-Sacado::Fad::SLFad<double, MAXSTACKDIMENSIONS> keeps the derivative array on the stack, but only uses as many of its
+MAXSTACKDIMENSIONS entries as diff() asks for; a middle ground when the size is known at runtime but bounded.
+
+Set USEJACOBIANFREE to true to skip the Jacobian altogether (Jacobian-free Newton-Krylov):
+"updateGuessJacobianFree" solves step 5 with GMRES (krylov_solvers.hpp), which only needs products of the Jacobian
+with a vector v. Each product is the derivative of the model along v, from one evaluation with a single-derivative
+AD type (DirectionalF) whose dx(0) is seeded with v, so no NUMDIMENSIONS x NUMDIMENSIONS matrix is ever stored or factored.
+F(x) itself is then evaluated in plain doubles ("calculateDependentVariablesValuesOnly"), since nothing reads the
+partial derivatives FadType would carry along.
+With USEINEXACTNEWTON, GMRES is only asked for the relative tolerance that the Eisenstat-Walker forcing term
+(forcing_term.hpp) derives from how fast the residual error is dropping, instead of KRYLOVTOLERANCE on every step.
+The GMRES iterations of every step are printed, and their total at the end.
+
+The Broyden, modified Newton and mixed-precision modes (USEBROYDENUPDATES, USEMODIFIEDNEWTON, USEMIXEDPRECISION)
+are described in forward_difference.cpp, which also lists the modes that can be combined; the Jacobian they factor
+is read from the AD evaluation.
 
 The Jacobian matrix looks like this:
 dE1/dx | dE1/dy | dE1/dz
@@ -63,63 +94,152 @@ As of 20 Aug. 2013, Armadillo can be obtained at: http://arma.sourceforge.net/
 #include <Sacado.hpp>
 #include <armadillo>
 #include <valarray>
-
-typedef Sacado::Fad::DFad<double>  F;  // Forward AD with # of ind. vars given later
+#include "broyden_update.hpp"
+#include "forcing_term.hpp"
+#include "krylov_solvers.hpp"
+#include "lu_factorization.hpp"
+#include "mixed_precision_solver.hpp"
+#include "small_linear_solver.hpp"
 
 const int NUMDIMENSIONS = 3;
 const int MAXITERATIONS = 9;
 const double ERRORTOLLERANCE = 1.0E-4;
 //No probing is done with AD as in the other methods
+const int MAXSTACKDIMENSIONS = 8;
+const bool USEJACOBIANFREE = false;
+const int MAXKRYLOVITERATIONS = 30;
+const int KRYLOVRESTART = 10;
+const double KRYLOVTOLERANCE = 1.0E-6;
+const bool USEINEXACTNEWTON = false;
+const double INITIALFORCINGTERM = 0.5;
+const double MAXFORCINGTERM = 0.9;
+const bool USEBROYDENUPDATES = false;
+const int MAXBROYDENUPDATES = 10;
+const bool USEMODIFIEDNEWTON = false;
+const int MAXFACTORIZATIONREUSES = 5;
+const double MAXRESIDUALRATIO = 0.5;
+const bool USEMIXEDPRECISION = false;
+const int MAXREFINEMENTS = 5;
+const double REFINEMENTTOLERANCE = 1.0E-14;
+
+static_assert(int(USEJACOBIANFREE) + int(USEBROYDENUPDATES) + int(USEMODIFIEDNEWTON) <= 1,
+	      "USEJACOBIANFREE, USEBROYDENUPDATES and USEMODIFIEDNEWTON exclude each other");
+static_assert(not USEMIXEDPRECISION or not (USEJACOBIANFREE or USEBROYDENUPDATES or USEMODIFIEDNEWTON),
+	      "USEMIXEDPRECISION only applies to the plain Newton step");
 
-void calculateDependentVariables(const std::valarray<F>& myOffsets,
-				 const std::valarray<F>& myCurrentGuess, 
-		                 std::valarray<F>& targetsCalculated);
+typedef Sacado::Fad::DFad<double>  F;  // Forward AD with # of ind. vars given later
+typedef Sacado::Fad::SFad<double, NUMDIMENSIONS>  SF;  // Forward AD with # of ind. vars fixed at compile time
+typedef Sacado::Fad::SLFad<double, MAXSTACKDIMENSIONS>  SLF;  // Forward AD with # of ind. vars given later, at most MAXSTACKDIMENSIONS
+typedef Sacado::Fad::SFad<double, 1>  DirectionalF;  // Forward AD along one direction, for Jacobian-vector products
 
-void calculateJacobian(const std::valarray<F>& myOffsets,
-			arma::Mat<double>& myJacobian, 
-		       std::valarray<F>& myTargetsCalculated, 
-		       std::valarray<F>& myCurrentGuess, 
-		       void myCalculateDependentVariables(const std::valarray<F>&, const std::valarray<F>&, std::valarray<F>&));
+//Which of the forward AD types above to run the example with
+enum ADType {DYNAMICFAD, STATICFAD, STATICLIMITEDFAD};
+const ADType ADTYPE = STATICFAD;
 
-void updateGuess(std::valarray<F>& myCurrentGuess,
+//This model is specific to a single problem
+class ParaboloidModel
+{
+public:
+	ParaboloidModel()
+	{
+		//Offsets of the paraboloids, one row per equation
+		for(int k = 0; k < NUMDIMENSIONS*NUMDIMENSIONS; k++)
+		{
+			myOffsets[k] = 0.0;
+		}
+		myOffsets[0] = 1.0;
+		myOffsets[2*NUMDIMENSIONS -1] = 1.0;
+		myOffsets[3*NUMDIMENSIONS -1] = 1.0;
+	}
+
+	template <typename Scalar>
+	void operator()(const std::valarray<Scalar>& myCurrentGuess, std::valarray<Scalar>& targetsCalculated) const;
+
+private:
+	double myOffsets[NUMDIMENSIONS*NUMDIMENSIONS];
+};
+
+template <typename FadType>
+void calculateJacobian(arma::Mat<double>& myJacobian, 
+		       const std::valarray<FadType>& myTargetsCalculated);
+
+template <typename FadType>
+void updateGuess(std::valarray<FadType>& myCurrentGuess,
 		arma::Col<double>& mySolutionTemp,
 		arma::Col<double>& myTargetsCalculatedValuesOnly,
-		 const std::valarray<F>& myTargetsCalculated,
+		 const std::valarray<FadType>& myTargetsCalculated,
 		 const arma::Mat<double>& myJacobian);
 
-void calculateResidual(const std::valarray<F>& myTargetsDesired, 
-		       const std::valarray<F>& myTargetsCalculated,
+template <typename FadType, class Model>
+int updateGuessJacobianFree(std::valarray<FadType>& myCurrentGuess,
+			    const std::valarray<FadType>& myTargetsCalculated,
+			    EisenstatWalkerForcingTerm& myForcingTerm,
+			    const Model& myCalculateDependentVariables);
+
+template <typename FadType, class Model>
+void calculateDependentVariablesValuesOnly(const std::valarray<FadType>& myCurrentGuess,
+					   std::valarray<FadType>& myTargetsCalculated,
+					   const Model& myCalculateDependentVariables);
+
+template <typename FadType>
+void updateGuessBroyden(std::valarray<FadType>& myCurrentGuess,
+			arma::Col<double>& myTargetsCalculatedValuesOnly,
+			const std::valarray<FadType>& myTargetsCalculated,
+			BroydenUpdate& myBroydenUpdate);
+
+template <typename FadType>
+void updateGuessModifiedNewton(std::valarray<FadType>& myCurrentGuess,
+			       arma::Col<double>& myTargetsCalculatedValuesOnly,
+			       const std::valarray<FadType>& myTargetsCalculated,
+			       const LUFactorization& myFactorization,
+			       const FactorizationReusePolicy& myReusePolicy);
+
+template <typename FadType>
+void calculateResidual(const std::valarray<FadType>& myTargetsDesired, 
+		       const std::valarray<FadType>& myTargetsCalculated,
 		       double& myError);
 
+template <typename FadType>
+int solveParaboloids(const char* myFadName);
+
 int main(int argc, char* argv[])
 {
-	//--This first declaration is included for software engineering reasons: allow main method to control flow of data
-	//create function pointer for calculateDependentVariable
-	//We want to do this so that calculateJacobian can call calculateDependentVariables as it needs to,
-	//but we explicitly give it this authority from the main method
-	void (*yourCalculateDependentVariables)(const std::valarray<F>&, const std::valarray<F>&, std::valarray<F>&);
-	yourCalculateDependentVariables = &calculateDependentVariables;
+	switch(ADTYPE)
+	{
+		case DYNAMICFAD:
+			return solveParaboloids<F>("Sacado::Fad::DFad");
+		case STATICFAD:
+			return solveParaboloids<SF>("Sacado::Fad::SFad");
+		case STATICLIMITEDFAD:
+			return solveParaboloids<SLF>("Sacado::Fad::SLFad");
+	}
+	return 1;
+}
 
+template <typename FadType>
+int solveParaboloids(const char* myFadName)
+{
 	//The problem being solved is to find the intersection of three infinite paraboloids:
 	//(x-1)^2 + y^2 + z = 0
 	//x^2 + y^2 -(z+1) = 0
 	//x^2 + y^2 +(z-1) = 0
 	//
 	//They should intersect at the point (1, 0, 0)
-	std::valarray<F> offsets(0.0, NUMDIMENSIONS*NUMDIMENSIONS); 
-	offsets[0] = 1.0;
-	offsets[2*NUMDIMENSIONS -1] = 1.0;
-	offsets[3*NUMDIMENSIONS -1] = 1.0;
+	//--This declaration is included for software engineering reasons: allow main method to control flow of data
+	//create the model as a function object that carries the offsets with it
+	//We want to do this so that updateGuessJacobianFree can call the model as it needs to,
+	//but we explicitly give it this authority from the main method
+	ParaboloidModel yourCalculateDependentVariables;
 
 	//We need to initialize the target vectors and provide an initial guess
-	std::valarray<F> targetsDesired(0.0, NUMDIMENSIONS);
+	std::valarray<FadType> targetsDesired(0.0, NUMDIMENSIONS);
 
-	std::valarray<F> targetsCalculated(0.0, NUMDIMENSIONS);
+	std::valarray<FadType> targetsCalculated(0.0, NUMDIMENSIONS);
 
 	arma::Col<double> targetsCalculatedValuesOnly(NUMDIMENSIONS);
 	targetsCalculatedValuesOnly.fill(0.0);
 
-	std::valarray<F> currentGuess(2.0, NUMDIMENSIONS);
+	std::valarray<FadType> currentGuess(2.0, NUMDIMENSIONS);
 	//designate the elements of the currentGuess vector as independent variables that we want to take partial derivatives
 	//with respect to later on in the program.
 	for(int i = 0; i < NUMDIMENSIONS; i++)
@@ -136,38 +256,150 @@ int main(int argc, char* argv[])
 	arma::Mat<double> jacobian(NUMDIMENSIONS, NUMDIMENSIONS);
 	jacobian.fill(0.0);
 
+	//Factors of the last Jacobian and the Broyden updates applied since
+	BroydenUpdate broydenUpdate(MAXBROYDENUPDATES);
+
+	//Relative tolerance of every Jacobian-free Newton step, and the GMRES iterations they took
+	EisenstatWalkerForcingTerm forcingTerm(INITIALFORCINGTERM, MAXFORCINGTERM);
+	int krylovIterations = 0;
+
+	//Factors of the last Jacobian for modified Newton, and when to refresh them
+	LUFactorization factorization;
+	FactorizationReusePolicy reusePolicy(MAXFACTORIZATIONREUSES, MAXRESIDUALRATIO);
+
+	//F(x) of the initial guess, its partial derivatives give the first Jacobian
+	//The Jacobian-free mode never reads them, so it evaluates F(x) in plain doubles
+	if(USEJACOBIANFREE)
+	{
+		calculateDependentVariablesValuesOnly(currentGuess,
+						      targetsCalculated,
+						      yourCalculateDependentVariables);
+	}
+	else
+	{
+		yourCalculateDependentVariables(currentGuess,
+						targetsCalculated);
+	}
+
 	int count = 0;
 	double error = 1.0E5;
+	double previousError = error;
 
 	std::cout << "Running automatic differentiation example ................" << std::endl;
+	std::cout << "Forward AD type: " << myFadName << std::endl;
 	while(count < MAXITERATIONS and error > ERRORTOLLERANCE)
 	{
 
-		//Calculate Jacobian tangent to currentGuess point
-		//at the same time, an unperturbed targetsCalculated is, well, calculated
-		calculateJacobian(offsets,
-				  jacobian,
-				  targetsCalculated,
-				  currentGuess,
-                                  yourCalculateDependentVariables);
-
-		//Compute a guessChange and immediately set the currentGuess equal to the guessChange
- 		updateGuess(currentGuess,
-			    solutionTemp,
-			    targetsCalculatedValuesOnly,
-			    targetsCalculated,
-			    jacobian);
+		if(USEJACOBIANFREE)
+		{
+			//Compute a new currentGuess from Jacobian-vector products only
+			krylovIterations += updateGuessJacobianFree(currentGuess,
+								    targetsCalculated,
+								    forcingTerm,
+								    yourCalculateDependentVariables);
+		}
+		else
+		{
+			//With Broyden updates or modified Newton the Jacobian is only recomputed when the old one is used up
+			bool needsJacobian = true;
+			if(USEBROYDENUPDATES)
+			{
+				needsJacobian = broydenUpdate.needsJacobian();
+			}
+			else if(USEMODIFIEDNEWTON)
+			{
+				needsJacobian = reusePolicy.needsRefresh();
+			}
+
+			if(needsJacobian)
+			{
+				//Calculate Jacobian tangent to currentGuess point
+				//from the derivatives the last evaluation of targetsCalculated carried along, no new evaluation
+				calculateJacobian(jacobian,
+						  targetsCalculated);
+
+				if(USEBROYDENUPDATES)
+				{
+					//Singular factors are not kept: updateGuessBroyden skips the step and, since needsJacobian
+					//stays true, the next iteration tries a fresh Jacobian again
+					broydenUpdate.reset(jacobian);
+				}
+				else if(USEMODIFIEDNEWTON)
+				{
+					//Singular factors are not kept, the next iteration tries a fresh Jacobian again
+					if(factorization.factor(jacobian))
+					{
+						reusePolicy.refreshed();
+					}
+					else
+					{
+						reusePolicy.invalidate();
+					}
+				}
+			}
+
+			//Compute a guessChange and immediately set the currentGuess equal to the guessChange
+			if(USEBROYDENUPDATES)
+			{
+				updateGuessBroyden(currentGuess,
+						   targetsCalculatedValuesOnly,
+						   targetsCalculated,
+						   broydenUpdate);
+			}
+			else if(USEMODIFIEDNEWTON)
+			{
+				updateGuessModifiedNewton(currentGuess,
+							  targetsCalculatedValuesOnly,
+							  targetsCalculated,
+							  factorization,
+							  reusePolicy);
+			}
+			else
+			{
+				updateGuess(currentGuess,
+					    solutionTemp,
+					    targetsCalculatedValuesOnly,
+					    targetsCalculated,
+					    jacobian);
+			}
+		}
 
 		//Compute F(x) with the updated, currentGuess
-		calculateDependentVariables(offsets,
-				            currentGuess,
-			       		    targetsCalculated);	
+		//its partial derivatives are the Jacobian of the next iteration, which the Jacobian-free mode does not need
+		if(USEJACOBIANFREE)
+		{
+			calculateDependentVariablesValuesOnly(currentGuess,
+							      targetsCalculated,
+							      yourCalculateDependentVariables);
+		}
+		else
+		{
+			yourCalculateDependentVariables(currentGuess,
+							targetsCalculated);
+		}
+
+		//The step just taken and the change in F(x) it caused update the approximate Jacobian
+		if(USEBROYDENUPDATES and not USEJACOBIANFREE)
+		{
+			for(int i = 0; i < NUMDIMENSIONS; i++)
+			{
+				targetsCalculatedValuesOnly[i] = targetsCalculated[i].val();
+			}
+			broydenUpdate.update(targetsCalculatedValuesOnly);
+		}
 
 		//Calculate the L2 norm of Ftarget - F(xCurrentGuess)
+		previousError = error;
 		calculateResidual(targetsDesired,
 			          targetsCalculated,
 			  	  error);	  
 
+		//A step that barely reduced the error means the stored factors are too far off
+		if(USEMODIFIEDNEWTON and not USEBROYDENUPDATES and not USEJACOBIANFREE)
+		{
+			reusePolicy.recordStep(previousError, error);
+		}
+
 		count ++;
 		//If we have converged, or if we have exceeded our alloted number of iterations, discontinue the loop
 		std::cout << "Residual Error: " << error << std::endl;
@@ -178,6 +410,10 @@ int main(int argc, char* argv[])
 	std::cout << "Final guess:\n x, y, z\n " << currentGuess[0].val() << ", " << currentGuess[1].val() << ", " << currentGuess[2].val() << std::endl;
 	std::cout << "Error tollerance: " << ERRORTOLLERANCE << std::endl;
 	std::cout << "Final error: " << error << std::endl;
+	if(USEJACOBIANFREE)
+	{
+		std::cout << "Total GMRES iterations: " << krylovIterations << std::endl;
+	}
 	std::cout << "--program complete--" << std::endl;
 
 	return 0;
@@ -185,32 +421,35 @@ int main(int argc, char* argv[])
 
 
 //This function is specific to a single problem
-void calculateDependentVariables(const std::valarray<F>& myOffsets,
-				 const std::valarray<F>& myCurrentGuess, 
-		                 std::valarray<F>& targetsCalculated)
+template <typename Scalar>
+void ParaboloidModel::operator()(const std::valarray<Scalar>& myCurrentGuess, std::valarray<Scalar>& targetsCalculated) const
 {
 	//Evaluate a dependent variable for each iteration
-	//The std::valarray<F> allows this to be expressed as a vector operation
+	//The sum of squares is written out element by element rather than with std::slice expressions,
+	//which would create temporary valarrays; with a fixed-size FadType the model then evaluates without allocating
+	Scalar difference;
 	for(int i = 0; i < NUMDIMENSIONS; i++)
 	{
-		targetsCalculated[i] = pow(myCurrentGuess[std::slice(0,2,1)] - myOffsets[std::slice(i*NUMDIMENSIONS, 2, 1)],2.0).sum();
+		targetsCalculated[i] = 0.0;
+		for(int k = 0; k < 2; k++)
+		{
+			difference = myCurrentGuess[k] - myOffsets[i*NUMDIMENSIONS + k];
+			targetsCalculated[i] += difference*difference;
+		}
 		targetsCalculated[i] = targetsCalculated[i] + myCurrentGuess[2]*pow(-1.0, i) - myOffsets[i*NUMDIMENSIONS + 2]; 
 		//std::cout << targetsCalculated[i] << std::endl;
 	}
 	//std::cout << "model evaluated *************************" << std::endl;
 	//std::cout << targetsCalculated << std::endl;
-	//std::cout << myOffsets << std::endl;
 	
 }
 
-void calculateJacobian(const std::valarray<F>& myOffsets,
-		       arma::Mat<double>& myJacobian, 
-		       std::valarray<F>& myTargetsCalculated, 
-		       std::valarray<F>& myCurrentGuess, 
-		       void myCalculateDependentVariables(const std::valarray<F>&, const std::valarray<F>&, std::valarray<F>&))
+template <typename FadType>
+void calculateJacobian(arma::Mat<double>& myJacobian, 
+		       const std::valarray<FadType>& myTargetsCalculated)
 {
-	//evaluate the model only once
-	myCalculateDependentVariables(myOffsets, myCurrentGuess, myTargetsCalculated);
+	//the model was evaluated only once, at the current guess
+	//every dependent variable holds its value and its partial derivatives w.r.t. all independent variables
 
 	//Each iteration fills a column in the Jacobian
 	//The Jacobian takes this form:
@@ -220,9 +459,6 @@ void calculateJacobian(const std::valarray<F>& myOffsets,
 	//
 	for(int j = 0; j< NUMDIMENSIONS; j++)
 	{
-
-		myCalculateDependentVariables(myOffsets, myCurrentGuess, myTargetsCalculated);
-
 		//extract the derivatives computed for us by the AD system
 		for(int i = 0; i < NUMDIMENSIONS; i++)
 		{
@@ -232,14 +468,15 @@ void calculateJacobian(const std::valarray<F>& myOffsets,
 	}
 }
 
-void updateGuess(std::valarray<F>& myCurrentGuess,
+template <typename FadType>
+void updateGuess(std::valarray<FadType>& myCurrentGuess,
 		arma::Col<double>& mySolutionTemp,
 		arma::Col<double>& myTargetsCalculatedValuesOnly,
-		 const std::valarray<F>& myTargetsCalculated,
+		 const std::valarray<FadType>& myTargetsCalculated,
 		 const arma::Mat<double>& myJacobian)
 {
-	//v = J(inverse) * (-F(x))
-	//new guess = v + old guess
+	//v = J(inverse) * F(x), from the fixed-size solver when NUMDIMENSIONS is small or by mixed precision
+	//new guess = old guess - v
 	for(int i = 0; i < NUMDIMENSIONS; i++)
 	{
 		myTargetsCalculatedValuesOnly[i] = myTargetsCalculated[i].val();
@@ -248,16 +485,169 @@ void updateGuess(std::valarray<F>& myCurrentGuess,
 	std::cout << "Current Jacobian: " << std::endl;
 	std::cout << myJacobian << std::endl;
 
-	mySolutionTemp = solve(myJacobian, -myTargetsCalculatedValuesOnly, true);
+	bool solved = true;
+	if(USEMIXEDPRECISION)
+	{
+		int refinements = solveMixedPrecision(myJacobian, myTargetsCalculatedValuesOnly, mySolutionTemp, REFINEMENTTOLERANCE, MAXREFINEMENTS);
+		std::cout << "Iterative refinement steps: " << refinements << std::endl;
+		solved = refinements >= 0;
+	}
+	else
+	{
+		solved = LinearSolver<NUMDIMENSIONS>::solve(myJacobian, myTargetsCalculatedValuesOnly, mySolutionTemp);
+	}
+	if(not solved)
+	{
+		std::cout << "Singular Jacobian, the guess is not updated" << std::endl;
+		return;
+	}
+
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		myCurrentGuess[i] -= mySolutionTemp[i];
+	}
+}
+
+template <typename FadType, class Model>
+void calculateDependentVariablesValuesOnly(const std::valarray<FadType>& myCurrentGuess,
+					   std::valarray<FadType>& myTargetsCalculated,
+					   const Model& myCalculateDependentVariables)
+{
+	//The model's operator() is templated on the scalar type, with double no derivatives are propagated
+	std::valarray<double> guessValuesOnly(NUMDIMENSIONS);
+	std::valarray<double> targetsCalculatedValuesOnly(NUMDIMENSIONS);
+	for(int j = 0; j < NUMDIMENSIONS; j++)
+	{
+		guessValuesOnly[j] = myCurrentGuess[j].val();
+	}
+	myCalculateDependentVariables(guessValuesOnly, targetsCalculatedValuesOnly);
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		myTargetsCalculated[i] = targetsCalculatedValuesOnly[i];
+	}
+}
+
+template <typename FadType, class Model>
+int updateGuessJacobianFree(std::valarray<FadType>& myCurrentGuess,
+			    const std::valarray<FadType>& myTargetsCalculated,
+			    EisenstatWalkerForcingTerm& myForcingTerm,
+			    const Model& myCalculateDependentVariables)
+{
+	//A copy of the guess that carries one derivative, the direction of the current product
+	//The model is evaluated with DirectionalF here, its operator() is templated on the scalar type
+	std::valarray<DirectionalF> directionalGuess(0.0, NUMDIMENSIONS);
+	for(int j = 0; j < NUMDIMENSIONS; j++)
+	{
+		directionalGuess[j] = DirectionalF(1, myCurrentGuess[j].val());
+	}
+	std::valarray<DirectionalF> directionalTargetsCalculated(0.0, NUMDIMENSIONS);
+
+	//myTargetsCalculated is F(x) from the end of the last iteration, the right hand side
+	arma::Col<double> targetsCalculatedValuesOnly(NUMDIMENSIONS);
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		targetsCalculatedValuesOnly[i] = myTargetsCalculated[i].val();
+	}
+
+	//Jacobian * v is the derivative of the model along v, seeded into the single derivative of the guess
+	auto jacobianVectorProduct = [&](const arma::Col<double>& myDirection, arma::Col<double>& myProduct)
+	{
+		for(int j = 0; j < NUMDIMENSIONS; j++)
+		{
+			directionalGuess[j].fastAccessDx(0) = myDirection[j];
+		}
+		myCalculateDependentVariables(directionalGuess, directionalTargetsCalculated);
+		myProduct.set_size(NUMDIMENSIONS);
+		for(int i = 0; i < NUMDIMENSIONS; i++)
+		{
+			myProduct[i] = directionalTargetsCalculated[i].dx(0);
+		}
+	};
+
+	//J * v = -F(x), solved for v = new guess - old guess
+	//Inexact Newton only solves as tightly as the drop in ||F(x)|| calls for
+	double linearTolerance = KRYLOVTOLERANCE;
+	if(USEINEXACTNEWTON)
+	{
+		linearTolerance = myForcingTerm.next(arma::norm(targetsCalculatedValuesOnly, 2), ERRORTOLLERANCE);
+	}
+	arma::Col<double> guessChange(NUMDIMENSIONS);
+	guessChange.fill(0.0);
+	double relativeLinearResidual = 0.0;
+	int krylovIterations = solveGMRES(jacobianVectorProduct,
+					  -targetsCalculatedValuesOnly,
+					  guessChange,
+					  linearTolerance,
+					  MAXKRYLOVITERATIONS,
+					  KRYLOVRESTART,
+					  relativeLinearResidual);
+	std::cout << "GMRES iterations: " << krylovIterations << ", linear tolerance: " << linearTolerance
+		  << ", relative linear residual: " << relativeLinearResidual << std::endl;
+
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		myCurrentGuess[i] += guessChange[i];
+	}
+	return krylovIterations;
+}
+
+template <typename FadType>
+void updateGuessModifiedNewton(std::valarray<FadType>& myCurrentGuess,
+			       arma::Col<double>& myTargetsCalculatedValuesOnly,
+			       const std::valarray<FadType>& myTargetsCalculated,
+			       const LUFactorization& myFactorization,
+			       const FactorizationReusePolicy& myReusePolicy)
+{
+	//v = J(inverse) * (-F(x)) with J the last factored Jacobian
+	//new guess = v + old guess
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		myTargetsCalculatedValuesOnly[i] = myTargetsCalculated[i].val();
+	}
+
+	if(not myFactorization.isFactored())
+	{
+		std::cout << "Singular Jacobian, the guess is not updated" << std::endl;
+		return;
+	}
+	std::cout << "Steps since the last factorization: " << myReusePolicy.stepsSinceRefresh() << std::endl;
+	arma::Col<double> guessChange = myFactorization.solve(-myTargetsCalculatedValuesOnly);
+
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		myCurrentGuess[i] += guessChange[i];
+	}
+}
+
+template <typename FadType>
+void updateGuessBroyden(std::valarray<FadType>& myCurrentGuess,
+			arma::Col<double>& myTargetsCalculatedValuesOnly,
+			const std::valarray<FadType>& myTargetsCalculated,
+			BroydenUpdate& myBroydenUpdate)
+{
+	//new guess = old guess - inverse(B) * F(x), where B is the last Jacobian with the Broyden updates applied
+	if(not myBroydenUpdate.isFactored())
+	{
+		std::cout << "Singular Jacobian, the guess is not updated" << std::endl;
+		return;
+	}
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		myTargetsCalculatedValuesOnly[i] = myTargetsCalculated[i].val();
+	}
+
+	std::cout << "Broyden updates since the last Jacobian: " << myBroydenUpdate.numUpdates() << std::endl;
+	arma::Col<double> guessChange = myBroydenUpdate.step(myTargetsCalculatedValuesOnly);
 
 	for(int i = 0; i < NUMDIMENSIONS; i++)
 	{
-		myCurrentGuess[i] += mySolutionTemp[i];
+		myCurrentGuess[i] += guessChange[i];
 	}
 }
 
-void calculateResidual(const std::valarray<F>& myTargetsDesired, 
-		       const std::valarray<F>& myTargetsCalculated,
+template <typename FadType>
+void calculateResidual(const std::valarray<FadType>& myTargetsDesired, 
+		       const std::valarray<FadType>& myTargetsCalculated,
 		       double& myError)
 {
 	//error is the l2 norm of the difference from my state to my target
@@ -0,0 +1,74 @@
+/*
+####Title:
+Parallel Batch Solve of Many Newton Raphson Problem Instances
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+"solveBatch" solves a batch of independent instances of one kind of system, each with its own model (e.g. its own
+offsets), initial guess and targets, with NewtonSolver (newton_solver.hpp). Instance i is:
+
+-myModels[i], the model function object of the instance
+-column i of myInitialGuesses and of myTargets
+
+The instances are spread over the workers of a ThreadPool (thread_pool.hpp) with "parallelForWorkStealing".
+Instances converge in very different numbers of iterations, so a static split would leave workers idle
+while others are still busy with slow instances; stealing keeps all of them working until the batch is done.
+
+The results are returned in contiguous buffers indexed like the input: column i of mySolutions is the final
+guess of instance i, and myResults[i] its iteration count, error and whether it converged.
+A batch whose myInitialGuesses or myTargets do not have one column per model, or whose two matrices differ in their
+number of rows, is not solved: "solveBatch" returns false with mySolutions and myResults empty, rather than let a
+worker index past the inputs.
+Every instance gets its own NewtonSolver, with copies of the Jacobian and linear solver policies, so the
+workers share nothing but the read-only inputs and write only to their own instances' outputs.
+*/
+
+#ifndef BATCH_SOLVER_HPP
+#define BATCH_SOLVER_HPP
+
+#include <vector>
+#include <armadillo>
+#include "newton_solver.hpp"
+#include "thread_pool.hpp"
+
+template <class Model, class JacobianPolicy, class LinearSolverPolicy>
+bool solveBatch(ThreadPool& myThreadPool,
+		const std::vector<Model>& myModels,
+		const arma::Mat<double>& myInitialGuesses,
+		const arma::Mat<double>& myTargets,
+		int myMaxIterations,
+		double myErrorTolerance,
+		const JacobianPolicy& myJacobianPolicy,
+		const LinearSolverPolicy& myLinearSolver,
+		arma::Mat<double>& mySolutions,
+		std::vector<NewtonResult>& myResults)
+{
+	const int numInstances = int(myModels.size());
+	if(myInitialGuesses.n_cols != myModels.size() or myTargets.n_cols != myModels.size() or
+	   myTargets.n_rows != myInitialGuesses.n_rows)
+	{
+		mySolutions.reset();
+		myResults.clear();
+		return false;
+	}
+	mySolutions.set_size(myInitialGuesses.n_rows, numInstances);
+	myResults.resize(numInstances);
+
+	myThreadPool.parallelForWorkStealing(numInstances, [&](int instance, int)
+	{
+		NewtonSolver<Model, JacobianPolicy, LinearSolverPolicy> solver(myModels[instance],
+									       myMaxIterations,
+									       myErrorTolerance,
+									       myJacobianPolicy,
+									       myLinearSolver);
+		arma::Col<double> guess = myInitialGuesses.col(instance);
+		arma::Col<double> targets = myTargets.col(instance);
+		myResults[instance] = solver.solve(guess, targets);
+		mySolutions.col(instance) = guess;
+	});
+	return true;
+}
+
+#endif
@@ -0,0 +1,422 @@
+/*
+####Title:
+Example Newton Raphson Solver: Batched Structure-of-Arrays Forward Difference
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+Program solves NUMPROBLEMS independent instances of the paraboloid intersection problem from forward_difference.cpp,
+each with its own offsets:
+
+(x-o00)^2 + (y-o01)^2 + z - o02 = 0
+(x-o10)^2 + (y-o11)^2 - z - o12 = 0
+(x-o20)^2 + (y-o21)^2 + z - o22 = 0
+
+Here only the constant terms vary: o02 = s, o12 = o22 = 1 + s with s drawn from [0, 1], so every instance has the
+root (1, sqrt(s), 0); s = 0 is the problem of forward_difference.cpp.
+
+Looping over the scalar example once per instance spends almost all of its time on per-call overhead: small heap
+allocations, LAPACK dispatch for a 3x3 solve and printing. The batch engine instead stores every quantity in
+structure-of-arrays (SoA) form, one contiguous array per scalar, indexed by instance ("lane"):
+
+guess[j][n], offsets[i*NUMDIMENSIONS + j][n], targets[i][n], jacobian[i*NUMDIMENSIONS + j][n], error[n], active[n]
+
+so every step of the Newton Raphson scheme is a loop over lanes with no branches that the compiler turns into SIMD
+instructions, each SIMD lane working on a different instance:
+1)"calculateDependentVariablesBatch" evaluates the model for a block of lanes
+2)"calculateJacobianBatch" perturbs column j of every lane at once, in a scratch copy of the guesses, and applies
+ the forward-difference formula
+3)"updateGuessBatch" solves every 3x3 system in closed form (Cramer's rule, the same operations in every lane)
+4)"calculateResidualBatch" computes the error of every lane and updates its mask
+
+Lanes are processed in blocks of BLOCKSIZE so that a block's arrays stay in cache for the whole iteration.
+A lane whose error is below ERRORTOLLERANCE is masked out: its "active" flag is cleared and the update is
+multiplied by it, so its guess no longer changes, without a branch in the inner loops. A block stops iterating as
+soon as none of its lanes is active. A lane with a singular Jacobian is masked out as well and reported as not converged.
+
+At the end the first NUMSCALARPROBLEMS instances are also solved one at a time, the way forward_difference.cpp does
+it, to check the answers and compare the time per instance. That scalar path takes the model as a callable, like
+forward_difference.cpp. "calculateDependentVariablesBatch" does not: it reads the offsets of every lane straight from
+the SoA arrays of the batch, and a model that evaluates one instance at a time would break up the lane loops it is
+written to vectorize.
+
+####Dependencies:
+Armadillo, only for the scalar comparison, see forward_difference.cpp.
+Compile with optimization and for the native instruction set (-O3 -march=native) so the lane loops are vectorized.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <armadillo>
+
+const int NUMDIMENSIONS = 3;
+const int MAXITERATIONS = 9;
+const double ERRORTOLLERANCE = 1.0E-4;
+//Every lane shares the probe distance, see forward_difference.cpp for the trade-off
+const double PROBEDISTANCE = 1.0E-8;
+const int NUMPROBLEMS = 1 << 20;
+const int BLOCKSIZE = 256;
+const int NUMSCALARPROBLEMS = 10000;
+
+//Every per-instance quantity, one array per scalar, indexed by lane
+struct ProblemBatch
+{
+	int numProblems;
+	std::vector<double> guess[NUMDIMENSIONS];
+	std::vector<double> offsets[NUMDIMENSIONS*NUMDIMENSIONS];
+	std::vector<double> targets[NUMDIMENSIONS];
+	std::vector<double> jacobian[NUMDIMENSIONS*NUMDIMENSIONS];
+	std::vector<double> error;
+	//1.0 while a lane is still iterating, 0.0 once it has converged or failed
+	std::vector<double> active;
+	std::vector<int> iterations;
+};
+
+void initializeBatch(ProblemBatch& myBatch,
+		     int myNumProblems);
+
+void calculateDependentVariablesBatch(const ProblemBatch& myBatch,
+				      const std::vector<double>* myGuess,
+				      std::vector<double>* myTargetsCalculated,
+				      int myFirstLane,
+				      int myLastLane);
+
+void calculateJacobianBatch(ProblemBatch& myBatch,
+			    std::vector<double>* myPerturbedGuess,
+			    std::vector<double>* myPerturbedTargetsCalculated,
+			    int myFirstLane,
+			    int myLastLane);
+
+void updateGuessBatch(ProblemBatch& myBatch,
+		      int myFirstLane,
+		      int myLastLane);
+
+int calculateResidualBatch(ProblemBatch& myBatch,
+			   int myFirstLane,
+			   int myLastLane);
+
+int solveBatch(ProblemBatch& myBatch);
+
+void calculateDependentVariables(const arma::Mat<double>& myOffsets,
+				 const arma::Col<double>& myCurrentGuess,
+				 arma::Col<double>& targetsCalculated);
+
+template <class Model>
+int solveScalar(const Model& myCalculateDependentVariables,
+		arma::Col<double>& myCurrentGuess,
+		double& myError);
+
+int main(int argc, char* argv[])
+{
+	ProblemBatch batch;
+	initializeBatch(batch, NUMPROBLEMS);
+
+	std::cout << "Running batched forward difference example ................" << std::endl;
+	std::cout << "Problem instances: " << NUMPROBLEMS << ", lanes per block: " << BLOCKSIZE << std::endl;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	int numConverged = solveBatch(batch);
+	double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	double largestError = 0.0;
+	long totalIterations = 0;
+	for(int n = 0; n < NUMPROBLEMS; n++)
+	{
+		largestError = std::max(largestError, batch.error[n]);
+		totalIterations += batch.iterations[n];
+	}
+
+	//The same instances, one at a time through the scalar path
+	double largestDifference = 0.0;
+	arma::Mat<double> offsets(NUMDIMENSIONS, NUMDIMENSIONS);
+	//The scalar path takes the model as a callable carrying the offsets, as forward_difference.cpp does
+	auto yourCalculateDependentVariables = [&offsets](const arma::Col<double>& myCurrentGuess, arma::Col<double>& myTargetsCalculated)
+	{
+		calculateDependentVariables(offsets, myCurrentGuess, myTargetsCalculated);
+	};
+	arma::Col<double> currentGuess(NUMDIMENSIONS);
+	double error = 0.0;
+	start = std::chrono::steady_clock::now();
+	for(int n = 0; n < NUMSCALARPROBLEMS; n++)
+	{
+		for(int i = 0; i < NUMDIMENSIONS; i++)
+		{
+			for(int j = 0; j < NUMDIMENSIONS; j++)
+			{
+				offsets(i, j) = batch.offsets[i*NUMDIMENSIONS + j][n];
+			}
+		}
+		currentGuess.fill(2.0);
+		solveScalar(yourCalculateDependentVariables, currentGuess, error);
+		for(int j = 0; j < NUMDIMENSIONS; j++)
+		{
+			largestDifference = std::max(largestDifference, std::fabs(currentGuess[j] - batch.guess[j][n]));
+		}
+	}
+	double scalarSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "******************************************" << std::endl;
+	std::cout << "Converged instances: " << numConverged << " of " << NUMPROBLEMS << std::endl;
+	std::cout << "Average number of iterations: " << double(totalIterations)/NUMPROBLEMS << std::endl;
+	std::cout << "Error tollerance: " << ERRORTOLLERANCE << std::endl;
+	std::cout << "Largest final error: " << largestError << std::endl;
+	std::cout << "Largest difference from the scalar solver: " << largestDifference << std::endl;
+	std::cout << "Batched: " << 1.0E9*batchSeconds/NUMPROBLEMS << " nanoseconds per instance" << std::endl;
+	std::cout << "Scalar:  " << 1.0E9*scalarSeconds/NUMSCALARPROBLEMS << " nanoseconds per instance" << std::endl;
+	std::cout << "Speedup: " << (scalarSeconds/NUMSCALARPROBLEMS)/(batchSeconds/NUMPROBLEMS) << std::endl;
+	std::cout << "--program complete--" << std::endl;
+
+	return 0;
+}
+
+
+//This function is specific to a single problem
+void initializeBatch(ProblemBatch& myBatch,
+		     int myNumProblems)
+{
+	myBatch.numProblems = myNumProblems;
+	for(int j = 0; j < NUMDIMENSIONS; j++)
+	{
+		myBatch.guess[j].assign(myNumProblems, 2.0);
+		myBatch.targets[j].assign(myNumProblems, 0.0);
+	}
+	for(int k = 0; k < NUMDIMENSIONS*NUMDIMENSIONS; k++)
+	{
+		myBatch.offsets[k].assign(myNumProblems, 0.0);
+		myBatch.jacobian[k].assign(myNumProblems, 0.0);
+	}
+	myBatch.error.assign(myNumProblems, 1.0E5);
+	myBatch.active.assign(myNumProblems, 1.0);
+	myBatch.iterations.assign(myNumProblems, 0);
+
+	//Same offsets as forward_difference.cpp, but every constant term is raised by s,
+	//which moves the root to (1, sqrt(s), 0)
+	std::srand(1);
+	for(int n = 0; n < myNumProblems; n++)
+	{
+		double s = double(std::rand())/RAND_MAX;
+		myBatch.offsets[0*NUMDIMENSIONS + 0][n] = 1.0;
+		myBatch.offsets[0*NUMDIMENSIONS + 2][n] = s;
+		myBatch.offsets[1*NUMDIMENSIONS + 2][n] = 1.0 + s;
+		myBatch.offsets[2*NUMDIMENSIONS + 2][n] = 1.0 + s;
+	}
+}
+
+//This function is specific to a single problem
+void calculateDependentVariablesBatch(const ProblemBatch& myBatch,
+				      const std::vector<double>* myGuess,
+				      std::vector<double>* myTargetsCalculated,
+				      int myFirstLane,
+				      int myLastLane)
+{
+	//Evaluate a dependent variable for each iteration, every lane at once
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		const double zSign = (i % 2 == 0) ? 1.0 : -1.0;
+		const double* x = &myGuess[0][0];
+		const double* y = &myGuess[1][0];
+		const double* z = &myGuess[2][0];
+		const double* xOffset = &myBatch.offsets[i*NUMDIMENSIONS + 0][0];
+		const double* yOffset = &myBatch.offsets[i*NUMDIMENSIONS + 1][0];
+		const double* zOffset = &myBatch.offsets[i*NUMDIMENSIONS + 2][0];
+		double* target = &myTargetsCalculated[i][0];
+		for(int n = myFirstLane; n < myLastLane; n++)
+		{
+			double dx = x[n] - xOffset[n];
+			double dy = y[n] - yOffset[n];
+			target[n] = dx*dx + dy*dy + zSign*z[n] - zOffset[n];
+		}
+	}
+}
+
+void calculateJacobianBatch(ProblemBatch& myBatch,
+			    std::vector<double>* myPerturbedGuess,
+			    std::vector<double>* myPerturbedTargetsCalculated,
+			    int myFirstLane,
+			    int myLastLane)
+{
+	//myBatch.targets holds the unperturbed evaluation from the end of the last iteration
+	//The probes go into a copy of the guess, so myBatch.guess is never touched, masked lanes included
+	for(int j = 0; j < NUMDIMENSIONS; j++)
+	{
+		std::copy(myBatch.guess[j].begin() + myFirstLane,
+			  myBatch.guess[j].begin() + myLastLane,
+			  myPerturbedGuess[j].begin() + myFirstLane);
+	}
+
+	//Each iteration fills a column in the Jacobian of every lane
+	for(int j = 0; j < NUMDIMENSIONS; j++)
+	{
+		const double* guess = &myBatch.guess[j][0];
+		double* perturbedGuess = &myPerturbedGuess[j][0];
+		for(int n = myFirstLane; n < myLastLane; n++)
+		{
+			perturbedGuess[n] = guess[n] + PROBEDISTANCE;
+		}
+
+		calculateDependentVariablesBatch(myBatch, myPerturbedGuess, myPerturbedTargetsCalculated, myFirstLane, myLastLane);
+
+		for(int i = 0; i < NUMDIMENSIONS; i++)
+		{
+			const double* perturbed = &myPerturbedTargetsCalculated[i][0];
+			const double* unperturbed = &myBatch.targets[i][0];
+			double* column = &myBatch.jacobian[i*NUMDIMENSIONS + j][0];
+			for(int n = myFirstLane; n < myLastLane; n++)
+			{
+				column[n] = (perturbed[n] - unperturbed[n]) * (1.0/PROBEDISTANCE);
+			}
+		}
+
+		for(int n = myFirstLane; n < myLastLane; n++)
+		{
+			perturbedGuess[n] = guess[n];
+		}
+	}
+}
+
+void updateGuessBatch(ProblemBatch& myBatch,
+		      int myFirstLane,
+		      int myLastLane)
+{
+	//v = J(inverse) * F(x) by Cramer's rule, new guess = old guess - active * v
+	//Every lane runs the same operations, a singular lane is masked out instead of branched around
+	std::vector<double>* J = myBatch.jacobian;
+	std::vector<double>* F = myBatch.targets;
+	for(int n = myFirstLane; n < myLastLane; n++)
+	{
+		double a = J[0][n], b = J[1][n], c = J[2][n];
+		double d = J[3][n], e = J[4][n], f = J[5][n];
+		double g = J[6][n], h = J[7][n], k = J[8][n];
+
+		//Cofactors of the first row, reused by the determinant
+		double cofactor0 = e*k - f*h;
+		double cofactor1 = f*g - d*k;
+		double cofactor2 = d*h - e*g;
+		double determinant = a*cofactor0 + b*cofactor1 + c*cofactor2;
+
+		double singular = (determinant == 0.0) ? 1.0 : 0.0;
+		myBatch.active[n] *= 1.0 - singular;
+		double scale = myBatch.active[n]/(determinant + singular);
+
+		double r0 = F[0][n], r1 = F[1][n], r2 = F[2][n];
+		double v0 = r0*cofactor0 + r1*(c*h - b*k) + r2*(b*f - c*e);
+		double v1 = r0*cofactor1 + r1*(a*k - c*g) + r2*(c*d - a*f);
+		double v2 = r0*cofactor2 + r1*(b*g - a*h) + r2*(a*e - b*d);
+
+		myBatch.guess[0][n] -= scale*v0;
+		myBatch.guess[1][n] -= scale*v1;
+		myBatch.guess[2][n] -= scale*v2;
+	}
+}
+
+int calculateResidualBatch(ProblemBatch& myBatch,
+			   int myFirstLane,
+			   int myLastLane)
+{
+	//error is the l2 norm of the difference from my state to my target (zero), only for lanes still iterating
+	int numActive = 0;
+	for(int n = myFirstLane; n < myLastLane; n++)
+	{
+		double wasActive = myBatch.active[n];
+		double squaredNorm = 0.0;
+		for(int i = 0; i < NUMDIMENSIONS; i++)
+		{
+			squaredNorm += myBatch.targets[i][n]*myBatch.targets[i][n];
+		}
+		myBatch.error[n] = wasActive*std::sqrt(squaredNorm) + (1.0 - wasActive)*myBatch.error[n];
+		myBatch.iterations[n] += int(wasActive);
+		myBatch.active[n] = wasActive*((myBatch.error[n] > ERRORTOLLERANCE) ? 1.0 : 0.0);
+		numActive += int(myBatch.active[n]);
+	}
+	return numActive;
+}
+
+int solveBatch(ProblemBatch& myBatch)
+{
+	//Scratch space for the perturbed guesses and evaluations, shared by every block
+	std::vector<double> perturbedGuess[NUMDIMENSIONS];
+	std::vector<double> perturbedTargetsCalculated[NUMDIMENSIONS];
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		perturbedGuess[i].assign(myBatch.numProblems, 0.0);
+		perturbedTargetsCalculated[i].assign(myBatch.numProblems, 0.0);
+	}
+
+	for(int firstLane = 0; firstLane < myBatch.numProblems; firstLane += BLOCKSIZE)
+	{
+		int lastLane = std::min(firstLane + BLOCKSIZE, myBatch.numProblems);
+
+		//F(x) of the initial guess
+		calculateDependentVariablesBatch(myBatch, myBatch.guess, myBatch.targets, firstLane, lastLane);
+
+		int numActive = lastLane - firstLane;
+		int count = 0;
+		while(count < MAXITERATIONS and numActive > 0)
+		{
+			calculateJacobianBatch(myBatch, perturbedGuess, perturbedTargetsCalculated, firstLane, lastLane);
+			updateGuessBatch(myBatch, firstLane, lastLane);
+			calculateDependentVariablesBatch(myBatch, myBatch.guess, myBatch.targets, firstLane, lastLane);
+			numActive = calculateResidualBatch(myBatch, firstLane, lastLane);
+			count++;
+		}
+	}
+
+	int numConverged = 0;
+	for(int n = 0; n < myBatch.numProblems; n++)
+	{
+		numConverged += (myBatch.error[n] <= ERRORTOLLERANCE) ? 1 : 0;
+	}
+	return numConverged;
+}
+
+//This function is specific to a single problem
+void calculateDependentVariables(const arma::Mat<double>& myOffsets,
+				 const arma::Col<double>& myCurrentGuess,
+				 arma::Col<double>& targetsCalculated)
+{
+	//Same model as forward_difference.cpp
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		targetsCalculated[i] = pow(myCurrentGuess[0] - myOffsets(i, 0), 2.0) + pow(myCurrentGuess[1] - myOffsets(i, 1), 2.0);
+		targetsCalculated[i] = targetsCalculated[i] + myCurrentGuess[2]*pow(-1.0, i) - myOffsets(i, 2);
+	}
+}
+
+template <class Model>
+int solveScalar(const Model& myCalculateDependentVariables,
+		arma::Col<double>& myCurrentGuess,
+		double& myError)
+{
+	//The Newton Raphson loop of forward_difference.cpp for one instance, without the printing
+	arma::Col<double> targetsCalculated(NUMDIMENSIONS);
+	arma::Col<double> perturbedGuess(NUMDIMENSIONS);
+	arma::Col<double> perturbedTargetsCalculated(NUMDIMENSIONS);
+	arma::Mat<double> jacobian(NUMDIMENSIONS, NUMDIMENSIONS);
+	myCalculateDependentVariables(myCurrentGuess, targetsCalculated);
+
+	int count = 0;
+	myError = 1.0E5;
+	while(count < MAXITERATIONS and myError > ERRORTOLLERANCE)
+	{
+		//Probe a copy, so the guess itself is not moved by a += / -= round trip
+		perturbedGuess = myCurrentGuess;
+		for(int j = 0; j < NUMDIMENSIONS; j++)
+		{
+			perturbedGuess[j] = myCurrentGuess[j] + PROBEDISTANCE;
+			myCalculateDependentVariables(perturbedGuess, perturbedTargetsCalculated);
+			jacobian.col(j) = (perturbedTargetsCalculated - targetsCalculated) * (1.0/PROBEDISTANCE);
+			perturbedGuess[j] = myCurrentGuess[j];
+		}
+
+		myCurrentGuess = myCurrentGuess - arma::solve(jacobian, targetsCalculated);
+		myCalculateDependentVariables(myCurrentGuess, targetsCalculated);
+		myError = arma::norm(targetsCalculated, 2);
+		count++;
+	}
+	return count;
+}
@@ -0,0 +1,132 @@
+/*
+####Title:
+Broyden Quasi-Newton Update for the Newton Raphson Examples
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+Instead of computing a new Jacobian every iteration, Broyden's method computes it once and then corrects it with
+the one piece of information every iteration provides for free: the step s that was taken and the change y in
+the model evaluation that it caused. The "good" Broyden update is the smallest change to the Jacobian B that makes
+it agree with that secant condition, B_new * s = y:
+
+B_new = B + (y - B*s) * s^T / (s^T * s)
+
+This class never forms B. It keeps the LU factorization of the last computed Jacobian, B0, and applies the updates
+to its inverse in product form (Sherman-Morrison):
+
+inverse(B_k) = (I + u_(k-1)*s_(k-1)^T) * ... * (I + u_0*s_0^T) * inverse(B0),	u = (s - inverse(B)*y) / (s^T * inverse(B)*y)
+
+so a step costs two triangular solves with the stored factors plus O(k*NUMDIMENSIONS) for the k stored updates:
+O(NUMDIMENSIONS^2) work and one model evaluation per iteration, instead of NUMDIMENSIONS+1 evaluations and an
+O(NUMDIMENSIONS^3) factorization.
+
+Usage from the main loop:
+1)"reset" with a freshly computed Jacobian whenever "needsJacobian" is true
+2)"step" returns the change to apply to the guess, given the current model evaluation F(x)
+3)"update" takes F(x + step) once the model has been evaluated at the new guess
+After maxUpdates updates, or if an update would divide by (nearly) zero, "needsJacobian" asks for a fresh Jacobian.
+A singular Jacobian given to "reset" is not kept: "reset" returns false, "isFactored" is false, "step" returns a
+zero step, "update" does nothing and "needsJacobian" keeps asking for a fresh Jacobian.
+*/
+
+#ifndef BROYDEN_UPDATE_HPP
+#define BROYDEN_UPDATE_HPP
+
+#include <cmath>
+#include <vector>
+#include <armadillo>
+#include "lu_factorization.hpp"
+
+class BroydenUpdate
+{
+public:
+	explicit BroydenUpdate(int maxUpdates)
+		: myMaxUpdates(maxUpdates)
+	{
+	}
+
+	bool needsJacobian() const
+	{
+		return not myFactorization.isFactored() or int(myUpdateDirections.size()) >= myMaxUpdates;
+	}
+
+	bool isFactored() const
+	{
+		return myFactorization.isFactored();
+	}
+
+	int numUpdates() const
+	{
+		return int(myUpdateDirections.size());
+	}
+
+	//Factor a freshly computed Jacobian and forget all previous updates, false if it is singular
+	bool reset(const arma::Mat<double>& jacobian)
+	{
+		myUpdateDirections.clear();
+		mySteps.clear();
+		return myFactorization.factor(jacobian);
+	}
+
+	//Broyden step for the model evaluation targetsCalculated = F(x), remembered for the next "update"
+	arma::Col<double> step(const arma::Col<double>& targetsCalculated)
+	{
+		myPreviousTargetsCalculated = targetsCalculated;
+		myPreviousStep = applyInverse(-targetsCalculated);
+		return myPreviousStep;
+	}
+
+	//Fold the secant information from the last step into the approximate inverse Jacobian
+	void update(const arma::Col<double>& targetsCalculated)
+	{
+		//No step was taken without factors
+		if(not myFactorization.isFactored())
+		{
+			return;
+		}
+
+		arma::Col<double> targetsChange = targetsCalculated - myPreviousTargetsCalculated;
+		arma::Col<double> inverseTimesChange = applyInverse(targetsChange);
+		double denominator = arma::dot(myPreviousStep, inverseTimesChange);
+
+		//The update is undefined if the step is (nearly) orthogonal to inverse(B)*y, start over from a new Jacobian
+		if(std::fabs(denominator) <= 1.0E-12*arma::norm(myPreviousStep, 2)*arma::norm(inverseTimesChange, 2))
+		{
+			myFactorization.clear();
+			return;
+		}
+
+		myUpdateDirections.push_back((myPreviousStep - inverseTimesChange)/denominator);
+		mySteps.push_back(myPreviousStep);
+	}
+
+private:
+	//inverse(B_k) * rightHandSide: two triangular solves with the stored factors, then the stored rank-one updates in order
+	arma::Col<double> applyInverse(const arma::Col<double>& rightHandSide) const
+	{
+		if(not myFactorization.isFactored())
+		{
+			arma::Col<double> zeroStep(rightHandSide.n_elem);
+			zeroStep.fill(0.0);
+			return zeroStep;
+		}
+
+		arma::Col<double> result = myFactorization.solve(rightHandSide);
+		for(size_t k = 0; k < mySteps.size(); k++)
+		{
+			result += myUpdateDirections[k]*arma::dot(mySteps[k], result);
+		}
+		return result;
+	}
+
+	int myMaxUpdates;
+	LUFactorization myFactorization;
+	std::vector<arma::Col<double> > myUpdateDirections;
+	std::vector<arma::Col<double> > mySteps;
+	arma::Col<double> myPreviousStep;
+	arma::Col<double> myPreviousTargetsCalculated;
+};
+
+#endif
@@ -0,0 +1,625 @@
+/*
+####Title:
+Example Newton Raphson Solver: Colored (Compressed) Forward Difference
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+Program solves the Broyden tridiagonal system, a classic banded test problem:
+
+(3 - 2*x_i)*x_i - x_(i-1) - 2*x_(i+1) + 1 = 0,	i = 0 ... NUMDIMENSIONS-1,	x_(-1) = x_(NUMDIMENSIONS) = 0
+
+Equation i only depends on x_(i-1), x_i and x_(i+1), so most entries of the Jacobian are structurally zero:
+
+dE0/dx0 | dE0/dx1 |         |
+-----------------------------------------
+dE1/dx0 | dE1/dx1 | dE1/dx2 |
+-----------------------------------------
+        | dE2/dx1 | dE2/dx2 | dE2/dx3
+-----------------------------------------
+        |         | dE3/dx2 | dE3/dx3
+
+The method "calculateDependentVariables" is specific to this problem, however everything else is largely general.
+
+The method "calculateJacobian" in forward_difference.cpp perturbs one independent variable per model evaluation,
+so every Jacobian costs NUMDIMENSIONS+1 evaluations. The method "calculateColoredJacobian" demonstrates the
+Curtis-Powell-Reid compression of the forward-difference technique:
+1)Columns of the sparsity pattern that share no row ("structurally orthogonal" columns) are given the same color
+by "colorJacobianColumns". This only has to be done once, since the pattern does not change between iterations.
+2)Unperturbed model evaluation is computed
+3)Every column of one color is perturbed at the same time and the model is re-evaluated
+4)Since no two columns of that color touch the same row, the change in each row over probe distance can only belong
+to one of the perturbed columns, and the sparsity pattern tells us which one.
+5)Steps 3 and 4 are repeated once per color.
+
+For a banded Jacobian the number of colors equals the bandwidth (3 here), so every Jacobian costs
+bandwidth+1 model evaluations no matter how large NUMDIMENSIONS is.
+
+The Jacobian is stored as a SparseJacobian (sparse_jacobian.hpp): the sparsity pattern in compressed sparse column
+form, built once, and one value per pattern entry, which "calculateColoredJacobian" writes directly. Nothing of size
+NUMDIMENSIONS x NUMDIMENSIONS is ever allocated, so the example scales to 10^5 unknowns and more.
+With USESPARSEJACOBIAN the Newton step is solved by sparse LU (SparseLU, sparse_lu.hpp, "updateGuessSparse"),
+which orders the columns and builds SuperLU's elimination tree for the first Jacobian only and then just redoes the
+numeric factorization with the same ordering every iteration; otherwise the values are copied into a dense matrix
+and solved with the dense "updateGuess", which is only sensible for small NUMDIMENSIONS.
+
+Sparse LU still creates fill-in, which can exhaust memory for very large Jacobians. Set LINEARSOLVER to GMRES or
+BICGSTAB to have "updateGuessKrylov" solve the Newton step iteratively instead (krylov_solvers.hpp), with only
+products of the sparse Jacobian and a preconditioner built from it (preconditioners.hpp): Jacobi, ILU(0) or
+block-Jacobi, chosen by PRECONDITIONER. The Jacobian is recomputed every iteration, but the preconditioner is kept
+for up to MAXPRECONDITIONERREUSES steps and only rebuilt early when a step reduces the residual error by less than
+MAXRESIDUALRATIO or the Krylov solve misses its tolerance.
+With USEINEXACTNEWTON that tolerance is not KRYLOVTOLERANCE on every step but the Eisenstat-Walker forcing term
+(forcing_term.hpp), loose while the residual error drops slowly and tight once Newton converges fast, so the early
+steps are not solved to a precision they cannot use. The Krylov iterations of every step are printed, and their
+total at the end.
+
+When the Jacobian is banded or block diagonal, "detectJacobianStructure" (structured_solvers.hpp) reads the
+bandwidths and the diagonal blocks off the sparsity pattern once, before the first iteration; LOWERBANDWIDTH,
+UPPERBANDWIDTH and BLOCKSIZE override what it finds when they are not negative. LINEARSOLVER = BANDEDLU then
+factors only the band with the partial pivoting band LU of LAPACK's dgbsv ("updateGuessBanded"), and
+BLOCKDIAGONALLU factors every diagonal block on its own ("updateGuessBlockDiagonal"); memory and solve time of both
+grow linearly with NUMDIMENSIONS. The tridiagonal system here is a single block, so BLOCKDIAGONALLU only pays off
+for models whose unknowns split into uncoupled groups, and a BLOCKSIZE that cuts through a coupling drops it.
+Bandwidths narrower than the detected ones are refused instead: BANDEDLU then leaves the guess unchanged and says
+that the Jacobian has entries outside the band.
+
+The Newton Raphson scheme is the same one described in forward_difference.cpp.
+
+####Dependencies:
+The "Armadillo" C++ API was chosen to handle the linear algebra tasks because of its clear syntax
+and integration with LAPACK. For a list of dependences and installation instructions for
+Armadillo refer to the Armadillo project page at sourceforge.net.
+
+As of 20 Aug. 2013, Armadillo can be obtained at: http://arma.sourceforge.net/
+The sparse solve calls SuperLU (version 5) directly, compile and link with it.
+*/
+
+#include <iostream>
+#include <vector>
+#include <armadillo>
+#include "forcing_term.hpp"
+#include "krylov_solvers.hpp"
+#include "lu_factorization.hpp"
+#include "preconditioners.hpp"
+#include "sparse_jacobian.hpp"
+#include "sparse_lu.hpp"
+#include "structured_solvers.hpp"
+
+const int NUMDIMENSIONS = 10;
+const int MAXITERATIONS = 9;
+const double ERRORTOLLERANCE = 1.0E-8;
+//If probe distance is made too small, subtractive cancellation may occur, leading to inaccurate derivatives
+//recompile with a small value for PROBEDISTANCE, like 1.0E-30 to see the effect
+const double PROBEDISTANCE = 1.0E-8;
+const bool USESPARSEJACOBIAN = true;
+enum LinearSolverType {SPARSELU, BANDEDLU, BLOCKDIAGONALLU, GMRES, BICGSTAB};
+const LinearSolverType LINEARSOLVER = SPARSELU;
+enum PreconditionerType {JACOBI, ILU0, BLOCKJACOBI};
+const PreconditionerType PRECONDITIONER = ILU0;
+const int PRECONDITIONERBLOCKSIZE = 4;
+const int MAXKRYLOVITERATIONS = 50;
+const int KRYLOVRESTART = 20;
+//The linear solve has to be tighter than ERRORTOLLERANCE, or it limits how close Newton can get
+const double KRYLOVTOLERANCE = 1.0E-10;
+const bool USEINEXACTNEWTON = false;
+const double INITIALFORCINGTERM = 0.5;
+const double MAXFORCINGTERM = 0.9;
+const int MAXPRECONDITIONERREUSES = 5;
+const double MAXRESIDUALRATIO = 0.5;
+//Negative values are detected from the sparsity pattern
+const int LOWERBANDWIDTH = -1;
+const int UPPERBANDWIDTH = -1;
+const int BLOCKSIZE = -1;
+
+void calculateDependentVariables(const arma::Mat<double>& myCoefficients,
+				 const arma::Col<double>& myCurrentGuess,
+				 arma::Col<double>& targetsCalculated);
+
+int colorJacobianColumns(const SparseJacobian& myJacobian,
+			 arma::Col<arma::uword>& myColumnColors);
+
+template <class Model>
+void calculateColoredJacobian(const arma::Col<arma::uword>& myColumnColors,
+			      int myNumColors,
+			      SparseJacobian& myJacobian,
+			      arma::Col<double>& myTargetsCalculated,
+			      arma::Col<double>& myCurrentGuess,
+			      const Model& myCalculateDependentVariables);
+
+void updateGuess(arma::Col<double>& myCurrentGuess,
+		 const arma::Col<double>& myTargetsCalculated,
+		 const arma::Mat<double>& myJacobian);
+
+void updateGuessSparse(arma::Col<double>& myCurrentGuess,
+		       const arma::Col<double>& myTargetsCalculated,
+		       const SparseJacobian& myJacobian,
+		       SparseLU& mySparseLU);
+
+int updateGuessKrylov(arma::Col<double>& myCurrentGuess,
+		      const arma::Col<double>& myTargetsCalculated,
+		      const SparseJacobian& myJacobian,
+		      Preconditioner& myPreconditioner,
+		      FactorizationReusePolicy& myReusePolicy,
+		      EisenstatWalkerForcingTerm& myForcingTerm);
+
+void updateGuessBanded(arma::Col<double>& myCurrentGuess,
+		       const arma::Col<double>& myTargetsCalculated,
+		       const SparseJacobian& myJacobian,
+		       BandedLU& myBandedLU);
+
+void updateGuessBlockDiagonal(arma::Col<double>& myCurrentGuess,
+			      const arma::Col<double>& myTargetsCalculated,
+			      const SparseJacobian& myJacobian,
+			      BlockDiagonalLU& myBlockDiagonalLU);
+
+void calculateResidual(const arma::Col<double>& myTargetsDesired,
+		       const arma::Col<double>& myTargetsCalculated,
+		       double& myError);
+
+int main(int argc, char* argv[])
+{
+	//The problem being solved is the Broyden tridiagonal system:
+	//(3 - 2*x_i)*x_i - x_(i-1) - 2*x_(i+1) + 1 = 0
+	//
+	//Each row holds the coefficients of x_(i-1), of the (3 - 2*x_i)*x_i term and of x_(i+1)
+	arma::Mat<double> coefficients(NUMDIMENSIONS, 3);
+	coefficients.col(0).fill(-1.0);
+	coefficients.col(1).fill(3.0);
+	coefficients.col(2).fill(-2.0);
+
+	//--This declaration is included for software engineering reasons: allow main method to control flow of data
+	//create a callable for calculateDependentVariables that carries the coefficients with it
+	//We want to do this so that calculateColoredJacobian can call calculateDependentVariables as it needs to,
+	//but we explicitly give it this authority from the main method
+	//calculateColoredJacobian takes the callable's type as a template parameter, so the model can be inlined
+	auto yourCalculateDependentVariables = [&coefficients](const arma::Col<double>& myCurrentGuess, arma::Col<double>& myTargetsCalculated)
+	{
+		calculateDependentVariables(coefficients, myCurrentGuess, myTargetsCalculated);
+	};
+
+	//The sparsity pattern lists, column by column, every row i where dEi/dxj may be nonzero
+	//For this problem it is the tridiagonal band: column j has rows j-1, j and j+1
+	arma::Col<arma::uword> rowIndices(3*NUMDIMENSIONS);
+	arma::Col<arma::uword> columnPointers(NUMDIMENSIONS + 1);
+	arma::uword numNonzeros = 0;
+	for(int j = 0; j < NUMDIMENSIONS; j++)
+	{
+		columnPointers[j] = numNonzeros;
+		for(int i = j - 1; i <= j + 1; i++)
+		{
+			if(i >= 0 and i < NUMDIMENSIONS)
+			{
+				rowIndices[numNonzeros] = i;
+				numNonzeros++;
+			}
+		}
+	}
+	columnPointers[NUMDIMENSIONS] = numNonzeros;
+	rowIndices.resize(numNonzeros);
+
+	//Place to store our tangent-stiffness matrix or Jacobian
+	//One value for every entry of the sparsity pattern, the pattern itself is built once here
+	SparseJacobian jacobian(rowIndices, columnPointers, NUMDIMENSIONS);
+
+	//Group structurally orthogonal columns, this is done once since the pattern never changes
+	arma::Col<arma::uword> columnColors(NUMDIMENSIONS);
+	int numColors = colorJacobianColumns(jacobian, columnColors);
+
+	//Bandwidths and diagonal blocks, also found once from the pattern
+	JacobianStructure structure = detectJacobianStructure(jacobian);
+	if(LOWERBANDWIDTH >= 0)
+	{
+		structure.lowerBandwidth = LOWERBANDWIDTH;
+	}
+	if(UPPERBANDWIDTH >= 0)
+	{
+		structure.upperBandwidth = UPPERBANDWIDTH;
+	}
+	if(BLOCKSIZE > 0)
+	{
+		structure.blockStarts.clear();
+		for(int first = 0; first < NUMDIMENSIONS; first += BLOCKSIZE)
+		{
+			structure.blockStarts.push_back(first);
+		}
+		structure.blockStarts.push_back(NUMDIMENSIONS);
+	}
+	BandedLU bandedLU(structure.lowerBandwidth, structure.upperBandwidth);
+	//Keeps the column ordering and elimination tree of the first sparse factorization for all later ones
+	SparseLU sparseLU;
+	BlockDiagonalLU blockDiagonalLU(structure.blockStarts);
+
+	//We need to initialize the target vectors and provide an initial guess
+	arma::Col<double> targetsDesired(NUMDIMENSIONS);
+	targetsDesired.fill(0.0);
+
+	arma::Col<double> targetsCalculated(NUMDIMENSIONS);
+	targetsCalculated.fill(0.0);
+
+	arma::Col<double> currentGuess(NUMDIMENSIONS);
+	currentGuess.fill(-1.0);
+
+	//Only one of the preconditioners is used, it is rebuilt when the reuse policy asks for it
+	JacobiPreconditioner jacobiPreconditioner;
+	ILU0Preconditioner ilu0Preconditioner;
+	BlockJacobiPreconditioner blockJacobiPreconditioner(PRECONDITIONERBLOCKSIZE);
+	Preconditioner* preconditioner = &ilu0Preconditioner;
+	if(PRECONDITIONER == JACOBI)
+	{
+		preconditioner = &jacobiPreconditioner;
+	}
+	else if(PRECONDITIONER == BLOCKJACOBI)
+	{
+		preconditioner = &blockJacobiPreconditioner;
+	}
+	FactorizationReusePolicy preconditionerReusePolicy(MAXPRECONDITIONERREUSES, MAXRESIDUALRATIO);
+
+	//Relative tolerance of every Krylov solve, and the Krylov iterations they took
+	EisenstatWalkerForcingTerm forcingTerm(INITIALFORCINGTERM, MAXFORCINGTERM);
+	int krylovIterations = 0;
+
+	int count = 0;
+	double error = 1.0E5;
+	double previousError = error;
+
+	std::cout << "Running colored forward difference example ..........." << std::endl;
+	std::cout << "Number of column colors: " << numColors << std::endl;
+	std::cout << "Stored Jacobian entries: " << jacobian.numNonzeros()
+		  << " (dense: " << double(NUMDIMENSIONS)*NUMDIMENSIONS << ")" << std::endl;
+	std::cout << "Model evaluations per Jacobian: " << numColors + 1
+		  << " (uncompressed: " << NUMDIMENSIONS + 1 << ")" << std::endl;
+	std::cout << "Lower bandwidth: " << structure.lowerBandwidth
+		  << ", upper bandwidth: " << structure.upperBandwidth
+		  << ", diagonal blocks: " << structure.blockStarts.size() - 1 << std::endl;
+	while(count < MAXITERATIONS and error > ERRORTOLLERANCE)
+	{
+
+		//Calculate Jacobian tangent to currentGuess point
+		//at the same time, an unperturbed targetsCalculated is, well, calculated
+		calculateColoredJacobian(columnColors,
+					 numColors,
+					 jacobian,
+					 targetsCalculated,
+					 currentGuess,
+					 yourCalculateDependentVariables);
+
+		//Compute a new currentGuess
+		if(USESPARSEJACOBIAN and LINEARSOLVER == BANDEDLU)
+		{
+			updateGuessBanded(currentGuess,
+					  targetsCalculated,
+					  jacobian,
+					  bandedLU);
+		}
+		else if(USESPARSEJACOBIAN and LINEARSOLVER == BLOCKDIAGONALLU)
+		{
+			updateGuessBlockDiagonal(currentGuess,
+						 targetsCalculated,
+						 jacobian,
+						 blockDiagonalLU);
+		}
+		else if(USESPARSEJACOBIAN and LINEARSOLVER != SPARSELU)
+		{
+			krylovIterations += updateGuessKrylov(currentGuess,
+							      targetsCalculated,
+							      jacobian,
+							      *preconditioner,
+							      preconditionerReusePolicy,
+							      forcingTerm);
+		}
+		else if(USESPARSEJACOBIAN)
+		{
+			updateGuessSparse(currentGuess,
+					  targetsCalculated,
+					  jacobian,
+					  sparseLU);
+		}
+		else
+		{
+			updateGuess(currentGuess,
+				    targetsCalculated,
+				    jacobian.dense());
+		}
+
+		//Compute F(x) with the updated, currentGuess
+		calculateDependentVariables(coefficients,
+					    currentGuess,
+					    targetsCalculated);
+
+		//Calculate the L2 norm of Ftarget - F(xCurrentGuess)
+		previousError = error;
+		calculateResidual(targetsDesired,
+				  targetsCalculated,
+				  error);
+
+		//A step that barely reduced the error means the preconditioner is too far off
+		preconditionerReusePolicy.recordStep(previousError, error);
+
+		count ++;
+		//If we have converged, or if we have exceeded our alloted number of iterations, discontinue the loop
+		std::cout << "Residual Error: " << error << std::endl;
+	}
+
+	std::cout << "******************************************" << std::endl;
+	std::cout << "Number of iterations: " << count << std::endl;
+	std::cout << "Final guess:\n " << currentGuess.t();
+	std::cout << "Error tollerance: " << ERRORTOLLERANCE << std::endl;
+	std::cout << "Final error: " << error << std::endl;
+	if(USESPARSEJACOBIAN and (LINEARSOLVER == GMRES or LINEARSOLVER == BICGSTAB))
+	{
+		std::cout << "Total Krylov iterations: " << krylovIterations << std::endl;
+	}
+	std::cout << "--program complete--" << std::endl;
+
+	return 0;
+}
+
+
+//This function is specific to a single problem
+void calculateDependentVariables(const arma::Mat<double>& myCoefficients,
+				 const arma::Col<double>& myCurrentGuess,
+				 arma::Col<double>& targetsCalculated)
+{
+	//Evaluate a dependent variable for each iteration
+	//Neighbours outside of the chain are taken to be zero
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		targetsCalculated[i] = (myCoefficients(i, 1) - 2.0*myCurrentGuess[i])*myCurrentGuess[i] + 1.0;
+		if(i > 0)
+		{
+			targetsCalculated[i] += myCoefficients(i, 0)*myCurrentGuess[i - 1];
+		}
+		if(i < NUMDIMENSIONS - 1)
+		{
+			targetsCalculated[i] += myCoefficients(i, 2)*myCurrentGuess[i + 1];
+		}
+	}
+}
+
+int colorJacobianColumns(const SparseJacobian& myJacobian,
+			 arma::Col<arma::uword>& myColumnColors)
+{
+	//Greedy Curtis-Powell-Reid coloring: each column takes the lowest color whose columns share no row with it
+	//rowsTaken[i][c] is true once some column of color c has a nonzero in row i
+	//Only the pattern entries are visited, so this costs O(nonzeros * colors) rather than O(NUMDIMENSIONS^2)
+	const arma::Col<arma::uword>& rowIndices = myJacobian.rowIndices();
+	const arma::Col<arma::uword>& columnPointers = myJacobian.columnPointers();
+	std::vector<std::vector<bool> > rowsTaken(myJacobian.numRows());
+	int numColors = 0;
+
+	for(arma::uword j = 0; j < myJacobian.numColumns(); j++)
+	{
+		arma::uword color = 0;
+		bool conflict = true;
+		while(conflict)
+		{
+			conflict = false;
+			for(arma::uword k = columnPointers[j]; k < columnPointers[j + 1]; k++)
+			{
+				const std::vector<bool>& colorsInRow = rowsTaken[rowIndices[k]];
+				if(color < colorsInRow.size() and colorsInRow[color])
+				{
+					conflict = true;
+					color++;
+					break;
+				}
+			}
+		}
+
+		myColumnColors[j] = color;
+		for(arma::uword k = columnPointers[j]; k < columnPointers[j + 1]; k++)
+		{
+			std::vector<bool>& colorsInRow = rowsTaken[rowIndices[k]];
+			if(colorsInRow.size() <= color)
+			{
+				colorsInRow.resize(color + 1, false);
+			}
+			colorsInRow[color] = true;
+		}
+		if(int(color) + 1 > numColors)
+		{
+			numColors = color + 1;
+		}
+	}
+
+	return numColors;
+}
+
+template <class Model>
+void calculateColoredJacobian(const arma::Col<arma::uword>& myColumnColors,
+			      int myNumColors,
+			      SparseJacobian& myJacobian,
+			      arma::Col<double>& myTargetsCalculated,
+			      arma::Col<double>& myCurrentGuess,
+			      const Model& myCalculateDependentVariables)
+{
+	//Calculate a temporary, unperturbed target evaluation, such as is needed for the finite-difference
+	//formula
+	arma::Col<double> unperturbedTargetsCalculated(NUMDIMENSIONS);
+	unperturbedTargetsCalculated.fill(0.0);
+	myCalculateDependentVariables(myCurrentGuess, unperturbedTargetsCalculated);
+	arma::Col<double> oldGuessValues = myCurrentGuess;
+
+	//Only the entries of the sparsity pattern are stored, and every one of them is written below
+	const arma::Col<arma::uword>& rowIndices = myJacobian.rowIndices();
+	const arma::Col<arma::uword>& columnPointers = myJacobian.columnPointers();
+	arma::Col<double>& jacobianValues = myJacobian.values();
+
+	//Each iteration fills every column of one color in the Jacobian
+	for(int color = 0; color < myNumColors; color++)
+	{
+		//Perturb all of the structurally orthogonal columns at once
+		for(int j = 0; j < NUMDIMENSIONS; j++)
+		{
+			if(myColumnColors[j] == arma::uword(color))
+			{
+				myCurrentGuess[j] += PROBEDISTANCE;
+			}
+		}
+
+		//Evaluate functions for perturbed guess
+		myCalculateDependentVariables(myCurrentGuess, myTargetsCalculated);
+
+		//Each row changed because of exactly one of the perturbed columns,
+		//so the finite-difference formula can be scattered back into the columns by the sparsity pattern
+		for(int j = 0; j < NUMDIMENSIONS; j++)
+		{
+			if(myColumnColors[j] != arma::uword(color))
+			{
+				continue;
+			}
+			for(arma::uword k = columnPointers[j]; k < columnPointers[j + 1]; k++)
+			{
+				arma::uword i = rowIndices[k];
+				jacobianValues[k] = (myTargetsCalculated[i] - unperturbedTargetsCalculated[i]) * pow(PROBEDISTANCE, -1.0);
+			}
+			myCurrentGuess[j] = oldGuessValues[j];
+		}
+	}
+
+	//Reset to unperturbed, so we dont waste a function evaluation
+	myTargetsCalculated = unperturbedTargetsCalculated;
+}
+
+void updateGuess(arma::Col<double>& myCurrentGuess,
+		 const arma::Col<double>& myTargetsCalculated,
+		 const arma::Mat<double>& myJacobian)
+{
+	//v = J(inverse) * (-F(x))
+	//new guess = v + old guess
+	std::cout << "Current Jacobian: " << std::endl;
+	std::cout << myJacobian << std::endl;
+	myCurrentGuess = myCurrentGuess + solve(myJacobian, -myTargetsCalculated, true);
+}
+
+void updateGuessSparse(arma::Col<double>& myCurrentGuess,
+		       const arma::Col<double>& myTargetsCalculated,
+		       const SparseJacobian& myJacobian,
+		       SparseLU& mySparseLU)
+{
+	//v = J(inverse) * F(x) by sparse LU, the Jacobian is far too large to print here
+	//new guess = old guess - v
+	arma::Col<double> guessChange(NUMDIMENSIONS);
+	if(not mySparseLU.factor(myJacobian) or not mySparseLU.solve(myTargetsCalculated, guessChange))
+	{
+		std::cout << "Singular Jacobian, the guess is not updated" << std::endl;
+		return;
+	}
+	myCurrentGuess = myCurrentGuess - guessChange;
+}
+
+int updateGuessKrylov(arma::Col<double>& myCurrentGuess,
+		      const arma::Col<double>& myTargetsCalculated,
+		      const SparseJacobian& myJacobian,
+		      Preconditioner& myPreconditioner,
+		      FactorizationReusePolicy& myReusePolicy,
+		      EisenstatWalkerForcingTerm& myForcingTerm)
+{
+	//v = J(inverse) * F(x) by a preconditioned Krylov method, only products with J are needed
+	//new guess = old guess - v
+	if(myReusePolicy.needsRefresh())
+	{
+		if(not myPreconditioner.build(myJacobian))
+		{
+			std::cout << "Preconditioner could not be built, the guess is not updated" << std::endl;
+			return 0;
+		}
+		myReusePolicy.refreshed();
+		std::cout << "Preconditioner rebuilt" << std::endl;
+	}
+
+	auto jacobianTimesVector = [&](const arma::Col<double>& myVector, arma::Col<double>& myProduct)
+	{
+		myJacobian.multiply(myVector, myProduct);
+	};
+
+	//Inexact Newton only solves as tightly as the drop in ||F(x)|| calls for
+	double linearTolerance = KRYLOVTOLERANCE;
+	if(USEINEXACTNEWTON)
+	{
+		linearTolerance = myForcingTerm.next(arma::norm(myTargetsCalculated, 2), ERRORTOLLERANCE);
+	}
+
+	arma::Col<double> guessChange(NUMDIMENSIONS);
+	guessChange.fill(0.0);
+	double relativeResidual = 0.0;
+	int iterations = 0;
+	if(LINEARSOLVER == BICGSTAB)
+	{
+		iterations = solveBiCGStab(jacobianTimesVector,
+					   myPreconditioner,
+					   myTargetsCalculated,
+					   guessChange,
+					   linearTolerance,
+					   MAXKRYLOVITERATIONS,
+					   relativeResidual);
+		std::cout << "BiCGStab iterations: " << iterations << ", linear tolerance: " << linearTolerance
+			  << ", relative linear residual: " << relativeResidual << std::endl;
+	}
+	else
+	{
+		iterations = solveGMRES(jacobianTimesVector,
+					myPreconditioner,
+					myTargetsCalculated,
+					guessChange,
+					linearTolerance,
+					MAXKRYLOVITERATIONS,
+					KRYLOVRESTART,
+					relativeResidual);
+		std::cout << "GMRES iterations: " << iterations << ", linear tolerance: " << linearTolerance
+			  << ", relative linear residual: " << relativeResidual << std::endl;
+	}
+
+	//The step is still taken, but the next one gets a fresh preconditioner
+	if(relativeResidual > linearTolerance)
+	{
+		myReusePolicy.invalidate();
+	}
+	myCurrentGuess = myCurrentGuess - guessChange;
+	return iterations;
+}
+
+void updateGuessBanded(arma::Col<double>& myCurrentGuess,
+		       const arma::Col<double>& myTargetsCalculated,
+		       const SparseJacobian& myJacobian,
+		       BandedLU& myBandedLU)
+{
+	//v = J(inverse) * F(x) by band LU, nothing outside of the band is stored or touched
+	//new guess = old guess - v
+	if(not myBandedLU.factor(myJacobian))
+	{
+		std::cout << "Singular Jacobian, or nonzeros outside LOWERBANDWIDTH/UPPERBANDWIDTH, the guess is not updated" << std::endl;
+		return;
+	}
+	arma::Col<double> guessChange(NUMDIMENSIONS);
+	myBandedLU.solve(myTargetsCalculated, guessChange);
+	myCurrentGuess = myCurrentGuess - guessChange;
+}
+
+void updateGuessBlockDiagonal(arma::Col<double>& myCurrentGuess,
+			      const arma::Col<double>& myTargetsCalculated,
+			      const SparseJacobian& myJacobian,
+			      BlockDiagonalLU& myBlockDiagonalLU)
+{
+	//v = J(inverse) * F(x), one small dense LU per diagonal block
+	//new guess = old guess - v
+	if(not myBlockDiagonalLU.factor(myJacobian))
+	{
+		std::cout << "Singular Jacobian, the guess is not updated" << std::endl;
+		return;
+	}
+	arma::Col<double> guessChange(NUMDIMENSIONS);
+	myBlockDiagonalLU.solve(myTargetsCalculated, guessChange);
+	myCurrentGuess = myCurrentGuess - guessChange;
+}
+
+void calculateResidual(const arma::Col<double>& myTargetsDesired,
+		       const arma::Col<double>& myTargetsCalculated,
+		       double& myError)
+{
+	//error is the l2 norm of the difference from my state to my target
+	myError = arma::norm((myTargetsDesired - myTargetsCalculated), 2);
+}
+
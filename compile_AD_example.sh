@@ -4,4 +4,4 @@
 #Armadillo API version 3.91
 #Trilinos API 11.0.3 configured with Teuchos and Sacado packages enabled
 
-g++ automatic_differentiation.cpp -larmadillo -lteuchos -o adexample.exe
+g++ -std=c++11 automatic_differentiation.cpp -larmadillo -lteuchos -o adexample.exe
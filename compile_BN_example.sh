@@ -0,0 +1,4 @@
+#!/bin/bash
+#Armadillo API version 3.91
+
+g++ -std=c++11 -O3 -march=native batched_newton.cpp -larmadillo -o bnexample.exe
@@ -0,0 +1,5 @@
+#!/bin/bash
+#Armadillo API version 3.91
+#SuperLU 5 for the sparse solve, headers under /usr/include/superlu on Debian and Ubuntu
+
+g++ -std=c++11 -I/usr/include/superlu colored_forward_difference.cpp -larmadillo -lsuperlu -o cfdexample.exe
@@ -3,4 +3,4 @@
 #Compiled with GCC 4.7
 #Armadillo API version 3.91
 
-g++ complex_step.cpp -larmadillo -o csexample.exe
+g++ -std=c++11 -pthread complex_step.cpp -larmadillo -o csexample.exe
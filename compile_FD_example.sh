@@ -3,4 +3,4 @@
 #Compiled with GCC 4.7
 #Armadillo API version 3.91
 
-g++ forward_difference.cpp -larmadillo -o fdexample.exe
+g++ -std=c++11 -pthread forward_difference.cpp -larmadillo -o fdexample.exe
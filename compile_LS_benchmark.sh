@@ -0,0 +1,4 @@
+#!/bin/bash
+#Armadillo API version 3.91
+
+g++ -std=c++11 -O2 small_solver_benchmark.cpp -larmadillo -o lsbenchmark.exe
@@ -0,0 +1,5 @@
+#!/bin/bash
+#Armadillo API version 3.91
+#Trilinos API 11.0.3 configured with Teuchos and Sacado packages enabled
+
+g++ -std=c++11 -O2 -pthread newton_solver_example.cpp -larmadillo -lteuchos -o nsexample.exe
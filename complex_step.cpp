@@ -46,6 +46,27 @@ The Newton Raphson scheme works like this:
 7)Loop back to step 1 and carry out subsequent steps until equations_results_from_guess_current is close to your target as desired
 --or-- the maximum number of iterations allowable has been exceeded according to your criteria.
 
+The method "calculateParallelJacobian" fills the same columns on the worker threads of a ThreadPool (thread_pool.hpp).
+Every worker perturbs its own copy of the guess and evaluates the model into its own buffer, so no two threads
+ever touch the same data; each column of the Jacobian is written by exactly one worker.
+It is off by default: for a model as cheap as this one, handing out a few columns costs more than it saves.
+Set USEPARALLELJACOBIAN to true for expensive models with many unknowns; the serial "calculateJacobian" is used otherwise.
+
+As in forward_difference.cpp, the model is handed to the Jacobian functions as a lambda that captures the offsets,
+and its type is a template parameter, so the model can be inlined instead of called through a function pointer.
+
+Set USEJACOBIANFREE to true to skip the Jacobian altogether (Jacobian-free Newton-Krylov):
+"updateGuessJacobianFree" solves step 5 with GMRES (krylov_solvers.hpp), which only needs products of the Jacobian
+with a vector v. Each product is a single complex-step probe along v:
+Jacobian * v = imag(F(x + i*h*v)) / h
+so no NUMDIMENSIONS x NUMDIMENSIONS matrix is ever stored or factored, and the products keep the accuracy of complex step.
+With USEINEXACTNEWTON, GMRES is only asked for the relative tolerance that the Eisenstat-Walker forcing term
+(forcing_term.hpp) derives from how fast the residual error is dropping, instead of KRYLOVTOLERANCE on every step.
+The GMRES iterations of every step are printed, and their total at the end.
+
+USEBROYDENUPDATES, USEMODIFIEDNEWTON and USEMIXEDPRECISION are the modes of forward_difference.cpp, see there for
+what they do and which of them combine; here they start from the complex-step Jacobian.
+
 ####Dependencies:
 The "Armadillo" C++ API was chosen to handle the linear algebra tasks because of its clear syntax
 and integration with LAPACK. For a list of dependences and installation instructions for
@@ -56,7 +77,16 @@ As of 20 Aug. 2013, Armadillo can be obtained at: http://arma.sourceforge.net/
 
 #include <complex>
 #include <iostream>
+#include <memory>
+#include <vector>
 #include <armadillo>
+#include "broyden_update.hpp"
+#include "forcing_term.hpp"
+#include "krylov_solvers.hpp"
+#include "lu_factorization.hpp"
+#include "mixed_precision_solver.hpp"
+#include "small_linear_solver.hpp"
+#include "thread_pool.hpp"
 
 const int NUMDIMENSIONS = 3;
 const int MAXITERATIONS = 9;
@@ -64,35 +94,72 @@ const double ERRORTOLLERANCE = 1.0E-4;
 //With the complex-step method, the only limit to the smallness of the probe distance we can select
 //may be machine precision
 const double PROBEDISTANCE = 1.0E-22;
+const bool USEPARALLELJACOBIAN = false;
+const int NUMTHREADS = 4;
+const bool USEJACOBIANFREE = false;
+const int MAXKRYLOVITERATIONS = 30;
+const int KRYLOVRESTART = 10;
+const double KRYLOVTOLERANCE = 1.0E-6;
+const bool USEINEXACTNEWTON = false;
+const double INITIALFORCINGTERM = 0.5;
+const double MAXFORCINGTERM = 0.9;
+const bool USEBROYDENUPDATES = false;
+const int MAXBROYDENUPDATES = 10;
+const bool USEMODIFIEDNEWTON = false;
+const int MAXFACTORIZATIONREUSES = 5;
+const double MAXRESIDUALRATIO = 0.5;
+const bool USEMIXEDPRECISION = false;
+const int MAXREFINEMENTS = 5;
+const double REFINEMENTTOLERANCE = 1.0E-14;
+
+static_assert(int(USEJACOBIANFREE) + int(USEBROYDENUPDATES) + int(USEMODIFIEDNEWTON) <= 1,
+	      "USEJACOBIANFREE, USEBROYDENUPDATES and USEMODIFIEDNEWTON exclude each other");
+static_assert(not USEMIXEDPRECISION or not (USEJACOBIANFREE or USEBROYDENUPDATES or USEMODIFIEDNEWTON),
+	      "USEMIXEDPRECISION only applies to the plain Newton step");
 
 void calculateDependentVariables(const arma::Mat<std::complex<double> >& myOffsets,
 				 const arma::Col<std::complex<double> >& myCurrentGuess, 
 		                 arma::Col<std::complex<double> >& targetsCalculated);
 
-void calculateJacobian(const arma::Mat<std::complex<double> >& myOffsets,
-			arma::Mat<double>& myJacobian, 
+template <class Model>
+void calculateJacobian(arma::Mat<double>& myJacobian, 
 		       arma::Col<std::complex<double> >& myTargetsCalculated, 
 		       arma::Col<std::complex<double> >& myCurrentGuess, 
-		       void myCalculateDependentVariables(const arma::Mat<std::complex<double> >&, const arma::Col<std::complex<double> >&, arma::Col<std::complex<double> >&));
+		       const Model& myCalculateDependentVariables);
+
+template <class Model>
+void calculateParallelJacobian(arma::Mat<double>& myJacobian,
+			       arma::Col<std::complex<double> >& myTargetsCalculated,
+			       const arma::Col<std::complex<double> >& myCurrentGuess,
+			       ThreadPool& myThreadPool,
+			       const Model& myCalculateDependentVariables);
 
 void updateGuess(arma::Col<std::complex<double> >& myCurrentGuess,
-		 arma::Mat<double>& myRealTargets,
+		 arma::Col<double>& myRealTargets,
 		 const arma::Col<std::complex<double> >& myTargetsDesired,
 		 const arma::Mat<double>& myJacobian);
 
+template <class Model>
+int updateGuessJacobianFree(arma::Col<std::complex<double> >& myCurrentGuess,
+			    const arma::Col<std::complex<double> >& myTargetsCalculated,
+			    EisenstatWalkerForcingTerm& myForcingTerm,
+			    const Model& myCalculateDependentVariables);
+
+void updateGuessBroyden(arma::Col<std::complex<double> >& myCurrentGuess,
+			const arma::Col<std::complex<double> >& myTargetsCalculated,
+			BroydenUpdate& myBroydenUpdate);
+
+void updateGuessModifiedNewton(arma::Col<std::complex<double> >& myCurrentGuess,
+			       const arma::Col<std::complex<double> >& myTargetsCalculated,
+			       const LUFactorization& myFactorization,
+			       const FactorizationReusePolicy& myReusePolicy);
+
 void calculateResidual(const arma::Col<std::complex<double> >& myTargetsDesired, 
 		       const arma::Col<std::complex<double> >& myTargetsCalculated,
 		       double& myError);
 
 int main(int argc, char* argv[])
 {
-	//--This first declaration is included for software engineering reasons: allow main method to control flow of data
-	//create function pointer for calculateDependentVariable
-	//We want to do this so that calculateJacobian can call calculateDependentVariables as it needs to,
-	//but we explicitly give it this authority from the main method
-	void (*yourCalculateDependentVariables)(const arma::Mat<std::complex<double> >&, const arma::Col<std::complex<double> >&, arma::Col<std::complex<double> >&);
-	yourCalculateDependentVariables = &calculateDependentVariables;
-
 	//The problem being solved is to find the intersection of three infinite paraboloids:
 	//(x-1)^2 + y^2 + z = 0
 	//x^2 + y^2 -(z+1) = 0
@@ -105,6 +172,17 @@ int main(int argc, char* argv[])
 	offsets.col(2)[1] = 1.0;
 	offsets.col(2)[2] = 1.0;
 
+	//--This declaration is included for software engineering reasons: allow main method to control flow of data
+	//create a callable for calculateDependentVariables that carries the offsets with it
+	//We want to do this so that calculateJacobian can call calculateDependentVariables as it needs to,
+	//but we explicitly give it this authority from the main method
+	//The Jacobian functions take the callable's type as a template parameter, so the model can be inlined
+	auto yourCalculateDependentVariables = [&offsets](const arma::Col<std::complex<double> >& myCurrentGuess,
+							  arma::Col<std::complex<double> >& myTargetsCalculated)
+	{
+		calculateDependentVariables(offsets, myCurrentGuess, myTargetsCalculated);
+	};
+
 	//We need to initialize the target vectors and provide an initial guess
 	arma::Col<std::complex<double> > targetsDesired(NUMDIMENSIONS);
 	targetsDesired.fill(0.0);
@@ -123,37 +201,147 @@ int main(int argc, char* argv[])
 	arma::Mat<double> jacobian(NUMDIMENSIONS, NUMDIMENSIONS);
 	jacobian.fill(0.0);
 
+	//The worker threads are created once here and reused by every Jacobian, none are started for the serial one
+	std::unique_ptr<ThreadPool> threadPool;
+	if(USEPARALLELJACOBIAN)
+	{
+		threadPool.reset(new ThreadPool(NUMTHREADS));
+	}
+
+	//Relative tolerance of every Jacobian-free Newton step, and the GMRES iterations they took
+	EisenstatWalkerForcingTerm forcingTerm(INITIALFORCINGTERM, MAXFORCINGTERM);
+	int krylovIterations = 0;
+
+	//Factors of the last Jacobian and the Broyden updates applied since
+	BroydenUpdate broydenUpdate(MAXBROYDENUPDATES);
+
+	//Factors of the last Jacobian for modified Newton, and when to refresh them
+	LUFactorization factorization;
+	FactorizationReusePolicy reusePolicy(MAXFACTORIZATIONREUSES, MAXRESIDUALRATIO);
+
 	int count = 0;
 	double error = 1.0E5;
+	double previousError = error;
+
+	//The Jacobian-free step has no Jacobian function to evaluate F at the initial guess,
+	//every later one comes from the end of the iteration before
+	if(USEJACOBIANFREE)
+	{
+		yourCalculateDependentVariables(currentGuess, targetsCalculated);
+	}
 
 	std::cout << "Running complex step example ................" << std::endl;
 	while(count < MAXITERATIONS and error > ERRORTOLLERANCE)
 	{
 
-		//Calculate Jacobian tangent to currentGuess point
-		//at the same time, an unperturbed targetsCalculated is, well, calculated
-		calculateJacobian(offsets,
-				  jacobian,
-				  targetsCalculated,
-				  currentGuess,
-                                  yourCalculateDependentVariables);
-
-		//Compute a new currentGuess 
-		updateGuess(currentGuess,
-			    realTargetsCalculated,
-			    targetsCalculated,
-			    jacobian);
+		if(USEJACOBIANFREE)
+		{
+			//Compute a new currentGuess from Jacobian-vector products only
+			krylovIterations += updateGuessJacobianFree(currentGuess,
+								    targetsCalculated,
+								    forcingTerm,
+								    yourCalculateDependentVariables);
+		}
+		else
+		{
+			//With Broyden updates or modified Newton the Jacobian is only recomputed when the old one is used up
+			bool needsJacobian = true;
+			if(USEBROYDENUPDATES)
+			{
+				needsJacobian = broydenUpdate.needsJacobian();
+			}
+			else if(USEMODIFIEDNEWTON)
+			{
+				needsJacobian = reusePolicy.needsRefresh();
+			}
+
+			if(needsJacobian)
+			{
+				//Calculate Jacobian tangent to currentGuess point
+				//at the same time, an unperturbed targetsCalculated is, well, calculated
+				if(USEPARALLELJACOBIAN)
+				{
+					calculateParallelJacobian(jacobian,
+								  targetsCalculated,
+								  currentGuess,
+								  *threadPool,
+								  yourCalculateDependentVariables);
+				}
+				else
+				{
+					calculateJacobian(jacobian,
+							  targetsCalculated,
+							  currentGuess,
+							  yourCalculateDependentVariables);
+				}
+
+				if(USEBROYDENUPDATES)
+				{
+					//Singular factors are not kept: updateGuessBroyden skips the step and, since needsJacobian
+					//stays true, the next iteration tries a fresh Jacobian again
+					broydenUpdate.reset(jacobian);
+				}
+				else if(USEMODIFIEDNEWTON)
+				{
+					//Singular factors are not kept, the next iteration tries a fresh Jacobian again
+					if(factorization.factor(jacobian))
+					{
+						reusePolicy.refreshed();
+					}
+					else
+					{
+						reusePolicy.invalidate();
+					}
+				}
+			}
+
+			//Compute a new currentGuess 
+			if(USEBROYDENUPDATES)
+			{
+				updateGuessBroyden(currentGuess,
+						   targetsCalculated,
+						   broydenUpdate);
+			}
+			else if(USEMODIFIEDNEWTON)
+			{
+				updateGuessModifiedNewton(currentGuess,
+							  targetsCalculated,
+							  factorization,
+							  reusePolicy);
+			}
+			else
+			{
+				updateGuess(currentGuess,
+					    realTargetsCalculated,
+					    targetsCalculated,
+					    jacobian);
+			}
+		}
 
 		//Compute F(x) with the updated, currentGuess
 		calculateDependentVariables(offsets,
 				            currentGuess,
 			       		    targetsCalculated);	
 
+		//The step just taken and the change in F(x) it caused update the approximate Jacobian
+		if(USEBROYDENUPDATES and not USEJACOBIANFREE)
+		{
+			realTargetsCalculated = arma::real(targetsCalculated);
+			broydenUpdate.update(realTargetsCalculated);
+		}
+
 		//Calculate the L2 norm of Ftarget - F(xCurrentGuess)
+		previousError = error;
 		calculateResidual(targetsDesired,
 			          targetsCalculated,
 			  	  error);	  
 
+		//A step that barely reduced the error means the stored factors are too far off
+		if(USEMODIFIEDNEWTON and not USEBROYDENUPDATES and not USEJACOBIANFREE)
+		{
+			reusePolicy.recordStep(previousError, error);
+		}
+
 		count ++;
 		//If we have converged, or if we have exceeded our alloted number of iterations, discontinue the loop
 		std::cout << "Residual Error: " << error << std::endl;
@@ -164,6 +352,10 @@ int main(int argc, char* argv[])
 	std::cout << "Final guess:\n x, y, z\n" << arma::real(currentGuess.t());
 	std::cout << "Error tollerance: " << ERRORTOLLERANCE << std::endl;
 	std::cout << "Final error: " << error << std::endl;
+	if(USEJACOBIANFREE)
+	{
+		std::cout << "Total GMRES iterations: " << krylovIterations << std::endl;
+	}
 	std::cout << "--program complete--" << std::endl;
 
 	return 0;
@@ -177,9 +369,13 @@ void calculateDependentVariables(const arma::Mat<std::complex<double> >& myOffse
 {
 	//Evaluate a dependent variable for each iteration
 	//The arma::Col allows this to be expressed as a vector operation
+	//The square is a product rather than pow(difference, 2.0): std::pow of a complex number goes through its
+	//logarithm, whose angle near pi drowns the tiny imaginary part of the probe whenever the real part is negative
+	arma::Col<std::complex<double> > difference(2);
 	for(int i = 0; i < NUMDIMENSIONS; i++)
 	{
-		targetsCalculated[i] = arma::sum(pow(myCurrentGuess.subvec(0,1) - myOffsets.row(i).subvec(0,1).t(),2.0));
+		difference = myCurrentGuess.subvec(0,1) - myOffsets.row(i).subvec(0,1).t();
+		targetsCalculated[i] = arma::sum(difference % difference);
 		targetsCalculated[i] = targetsCalculated[i] + myCurrentGuess[2]*pow(-1.0, i) - myOffsets.row(i)[2]; 
 		//std::cout << targetsCalculated[i] << std::endl;
 	}
@@ -189,17 +385,17 @@ void calculateDependentVariables(const arma::Mat<std::complex<double> >& myOffse
 	
 }
 
-void calculateJacobian(const arma::Mat<std::complex<double> >& myOffsets,
-		       arma::Mat<double>& myJacobian, 
+template <class Model>
+void calculateJacobian(arma::Mat<double>& myJacobian, 
 		       arma::Col<std::complex<double> >& myTargetsCalculated, 
 		       arma::Col<std::complex<double> >& myCurrentGuess, 
-		       void myCalculateDependentVariables(const arma::Mat<std::complex<double> >&, const arma::Col<std::complex<double> >&, arma::Col<std::complex<double> >&))
+		       const Model& myCalculateDependentVariables)
 {
 	//Calculate a temporary, unperturbed target evaluation, such as is needed for solving for the updated guess 
 	//formula
 	arma::Col<std::complex<double> > unperturbedTargetsCalculated(NUMDIMENSIONS);
 	unperturbedTargetsCalculated.fill(0.0);
-	myCalculateDependentVariables(myOffsets, myCurrentGuess, unperturbedTargetsCalculated);
+	myCalculateDependentVariables(myCurrentGuess, unperturbedTargetsCalculated);
 	std::complex<double> oldGuessValue(0.0, 0.0);
 
 	//Each iteration fills a column in the Jacobian
@@ -215,7 +411,7 @@ void calculateJacobian(const arma::Mat<std::complex<double> >& myOffsets,
 		myCurrentGuess[j] += std::complex<double>(0.0, PROBEDISTANCE);
 
 		//Evaluate functions for perturbed guess
-		myCalculateDependentVariables(myOffsets, myCurrentGuess, myTargetsCalculated);
+		myCalculateDependentVariables(myCurrentGuess, myTargetsCalculated);
 
 		//The column of the Jacobian that goes with the independent variable we perturbed
 		//can be determined using the finite-difference formula
@@ -238,17 +434,145 @@ void calculateJacobian(const arma::Mat<std::complex<double> >& myOffsets,
 	myTargetsCalculated = unperturbedTargetsCalculated;
 }
 
+template <class Model>
+void calculateParallelJacobian(arma::Mat<double>& myJacobian,
+			       arma::Col<std::complex<double> >& myTargetsCalculated,
+			       const arma::Col<std::complex<double> >& myCurrentGuess,
+			       ThreadPool& myThreadPool,
+			       const Model& myCalculateDependentVariables)
+{
+	//Calculate the unperturbed target evaluation, such as is needed for solving for the updated guess
+	myCalculateDependentVariables(myCurrentGuess, myTargetsCalculated);
+
+	//One perturbed copy of the guess and one output buffer per worker,
+	//so the shared myCurrentGuess is never modified
+	std::vector<arma::Col<std::complex<double> > > perturbedGuesses(myThreadPool.size(), myCurrentGuess);
+	std::vector<arma::Col<std::complex<double> > > perturbedTargetsCalculated(myThreadPool.size(), arma::Col<std::complex<double> >(NUMDIMENSIONS));
+
+	//Each task fills a column in the Jacobian, workers never write to the same column
+	myThreadPool.parallelFor(NUMDIMENSIONS, [&](int j, int worker)
+	{
+		arma::Col<std::complex<double> >& guess = perturbedGuesses[worker];
+		arma::Col<std::complex<double> >& targets = perturbedTargetsCalculated[worker];
+
+		guess[j] += std::complex<double>(0.0, PROBEDISTANCE);
+		myCalculateDependentVariables(guess, targets);
+		myJacobian.col(j) = arma::imag(targets);
+		myJacobian.col(j) *= pow(PROBEDISTANCE, -1.0);
+		guess[j] = myCurrentGuess[j];
+	});
+}
+
 void updateGuess(arma::Col<std::complex<double> >& myCurrentGuess,
-		 arma::Mat<double>& myRealTargets,
+		 arma::Col<double>& myRealTargets,
 		 const arma::Col<std::complex<double> >& myTargetsCalculated,
 		 const arma::Mat<double>& myJacobian)
 {
-	//v = J(inverse) * (-F(x))
-	//new guess = v + old guess
+	//v = J(inverse) * F(x), from the fixed-size solver when NUMDIMENSIONS is small or by mixed precision
+	//new guess = old guess - v
 	std::cout << "Current Jacobian: " << std::endl;
 	std::cout << myJacobian << std::endl;
 	myRealTargets = arma::real(myTargetsCalculated);
-	myCurrentGuess = myCurrentGuess + solve(myJacobian, -myRealTargets, true);
+	arma::Col<double> guessChange(NUMDIMENSIONS);
+	bool solved = true;
+	if(USEMIXEDPRECISION)
+	{
+		int refinements = solveMixedPrecision(myJacobian, myRealTargets, guessChange, REFINEMENTTOLERANCE, MAXREFINEMENTS);
+		std::cout << "Iterative refinement steps: " << refinements << std::endl;
+		solved = refinements >= 0;
+	}
+	else
+	{
+		solved = LinearSolver<NUMDIMENSIONS>::solve(myJacobian, myRealTargets, guessChange);
+	}
+	if(not solved)
+	{
+		std::cout << "Singular Jacobian, the guess is not updated" << std::endl;
+		return;
+	}
+	myCurrentGuess = myCurrentGuess - guessChange;
+}
+
+void updateGuessModifiedNewton(arma::Col<std::complex<double> >& myCurrentGuess,
+			       const arma::Col<std::complex<double> >& myTargetsCalculated,
+			       const LUFactorization& myFactorization,
+			       const FactorizationReusePolicy& myReusePolicy)
+{
+	//v = J(inverse) * (-F(x)) with J the last factored Jacobian
+	//new guess = v + old guess
+	if(not myFactorization.isFactored())
+	{
+		std::cout << "Singular Jacobian, the guess is not updated" << std::endl;
+		return;
+	}
+	std::cout << "Steps since the last factorization: " << myReusePolicy.stepsSinceRefresh() << std::endl;
+	arma::Col<double> realTargets = arma::real(myTargetsCalculated);
+	myCurrentGuess = myCurrentGuess + myFactorization.solve(-realTargets);
+}
+
+void updateGuessBroyden(arma::Col<std::complex<double> >& myCurrentGuess,
+			const arma::Col<std::complex<double> >& myTargetsCalculated,
+			BroydenUpdate& myBroydenUpdate)
+{
+	//new guess = old guess - inverse(B) * F(x), where B is the last Jacobian with the Broyden updates applied
+	if(not myBroydenUpdate.isFactored())
+	{
+		std::cout << "Singular Jacobian, the guess is not updated" << std::endl;
+		return;
+	}
+	std::cout << "Broyden updates since the last Jacobian: " << myBroydenUpdate.numUpdates() << std::endl;
+	arma::Col<double> realTargets = arma::real(myTargetsCalculated);
+	myCurrentGuess = myCurrentGuess + myBroydenUpdate.step(realTargets);
+}
+
+template <class Model>
+int updateGuessJacobianFree(arma::Col<std::complex<double> >& myCurrentGuess,
+			    const arma::Col<std::complex<double> >& myTargetsCalculated,
+			    EisenstatWalkerForcingTerm& myForcingTerm,
+			    const Model& myCalculateDependentVariables)
+{
+	//myTargetsCalculated is F(x) from the end of the last iteration, the right hand side
+	arma::Col<std::complex<double> > perturbedGuess(NUMDIMENSIONS);
+	arma::Col<std::complex<double> > perturbedTargetsCalculated(NUMDIMENSIONS);
+
+	//Jacobian * v from one complex-step probe along v
+	auto jacobianVectorProduct = [&](const arma::Col<double>& myDirection, arma::Col<double>& myProduct)
+	{
+		for(int j = 0; j < NUMDIMENSIONS; j++)
+		{
+			perturbedGuess[j] = myCurrentGuess[j] + std::complex<double>(0.0, PROBEDISTANCE*myDirection[j]);
+		}
+		myCalculateDependentVariables(perturbedGuess, perturbedTargetsCalculated);
+		myProduct = arma::imag(perturbedTargetsCalculated);
+		myProduct *= pow(PROBEDISTANCE, -1.0);
+	};
+
+	//J * v = -F(x), solved for v = new guess - old guess
+	arma::Col<double> realTargetsCalculated = arma::real(myTargetsCalculated);
+	//Inexact Newton only solves as tightly as the drop in ||F(x)|| calls for
+	double linearTolerance = KRYLOVTOLERANCE;
+	if(USEINEXACTNEWTON)
+	{
+		linearTolerance = myForcingTerm.next(arma::norm(realTargetsCalculated, 2), ERRORTOLLERANCE);
+	}
+	arma::Col<double> guessChange(NUMDIMENSIONS);
+	guessChange.fill(0.0);
+	double relativeLinearResidual = 0.0;
+	int krylovIterations = solveGMRES(jacobianVectorProduct,
+					  -realTargetsCalculated,
+					  guessChange,
+					  linearTolerance,
+					  MAXKRYLOVITERATIONS,
+					  KRYLOVRESTART,
+					  relativeLinearResidual);
+	std::cout << "GMRES iterations: " << krylovIterations << ", linear tolerance: " << linearTolerance
+		  << ", relative linear residual: " << relativeLinearResidual << std::endl;
+
+	for(int j = 0; j < NUMDIMENSIONS; j++)
+	{
+		myCurrentGuess[j] += guessChange[j];
+	}
+	return krylovIterations;
 }
 
 void calculateResidual(const arma::Col<std::complex<double> >& myTargetsDesired, 
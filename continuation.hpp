@@ -0,0 +1,205 @@
+/*
+####Title:
+Natural-Parameter Continuation of Newton Raphson Solutions
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+"sweepParameter" solves F(x; lambda) = targets for every value of a parameter lambda in myParameters (e.g. the
+shift of the paraboloid offsets), in order. myModelFamily(lambda) returns the model, a function object as taken
+by NewtonSolver (newton_solver.hpp), for one value of the parameter.
+
+Only the first value is solved from myInitialGuess. Every following solve is warm-started from a prediction of
+the solution at the next parameter value, made from the solutions already found:
+
+-SECANT: the line through the last two solutions, x + step*(x - x_previous)/(lambda - lambda_previous),
+ free since it uses no model evaluations
+-TANGENT: the tangent of the solution curve, x + step*dx/dlambda, where J*dx/dlambda = -dF/dlambda with the
+ Jacobian J of the last corrector iteration and dF/dlambda by a forward difference in lambda; F(x) is kept from the
+ last corrector, so this costs the one perturbed model evaluation; until some corrector has iterated there is no J,
+ and the secant is used instead
+
+The corrector is NewtonSolver started from the prediction. The parameter is not required to jump from one
+value of myParameters to the next in a single step: it advances by a step size that doubles after a corrector
+that took fewer than myTargetIterations iterations and halves after one that took more, so a coarse sweep is
+split into smaller steps where the solution curve bends and a fine sweep takes every value in one step. The step
+size is only capped by the distance left when the next parameter value is chosen, so a short last step onto a
+value of myParameters does not shrink the steps that follow. A step whose corrector fails is retried with half the
+step size, and the sweep is abandoned once the step size would drop below myMinStep; the remaining results are then
+left not converged. myMinStep is raised to eps*(1 + |lambda|) if it is smaller, so the step size never reaches 0.
+*/
+
+#ifndef CONTINUATION_HPP
+#define CONTINUATION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <valarray>
+#include <vector>
+#include <armadillo>
+#include "newton_solver.hpp"
+
+enum ContinuationPredictor {SECANT, TANGENT};
+
+struct ContinuationResult
+{
+	int numSteps;
+	int numRejectedSteps;
+	long totalIterations;
+	bool completed;
+};
+
+template <class ModelFamily, class JacobianPolicy, class LinearSolverPolicy>
+ContinuationResult sweepParameter(const ModelFamily& myModelFamily,
+				  const arma::Col<double>& myParameters,
+				  const arma::Col<double>& myInitialGuess,
+				  const arma::Col<double>& myTargets,
+				  int myMaxIterations,
+				  double myErrorTolerance,
+				  ContinuationPredictor myPredictor,
+				  int myTargetIterations,
+				  double myMinStep,
+				  const JacobianPolicy& myJacobianPolicy,
+				  const LinearSolverPolicy& myLinearSolver,
+				  arma::Mat<double>& mySolutions,
+				  std::vector<NewtonResult>& myResults)
+{
+	typedef decltype(myModelFamily(0.0)) Model;
+	typedef NewtonSolver<Model, JacobianPolicy, LinearSolverPolicy> Solver;
+
+	const arma::uword n = myInitialGuess.n_elem;
+	const int numParameters = int(myParameters.n_elem);
+	mySolutions.zeros(n, numParameters);
+	myResults.resize(numParameters);
+	for(int k = 0; k < numParameters; k++)
+	{
+		myResults[k].iterations = 0;
+		myResults[k].error = 1.0E5;
+		myResults[k].converged = false;
+		myResults[k].cancelled = false;
+	}
+
+	ContinuationResult result;
+	result.numSteps = 0;
+	result.numRejectedSteps = 0;
+	result.totalIterations = 0;
+	result.completed = false;
+	if(numParameters == 0)
+	{
+		result.completed = true;
+		return result;
+	}
+
+	//Cold start at the first parameter value
+	double parameter = myParameters[0];
+	arma::Col<double> solution = myInitialGuess;
+	Solver firstSolver(myModelFamily(parameter), myMaxIterations, myErrorTolerance, myJacobianPolicy, myLinearSolver);
+	myResults[0] = firstSolver.solve(solution, myTargets);
+	result.totalIterations += myResults[0].iterations;
+	if(not myResults[0].converged)
+	{
+		return result;
+	}
+	mySolutions.col(0) = solution;
+	arma::Mat<double> jacobian = firstSolver.jacobian();
+	//F(solution), from the corrector that found it
+	arma::Col<double> solutionValues = firstSolver.values();
+
+	bool havePrevious = false;
+	double previousParameter = parameter;
+	arma::Col<double> previousSolution = solution;
+	//Until a corrector says otherwise, every parameter value is reached in one step
+	double stepSize = std::numeric_limits<double>::infinity();
+
+	arma::Col<double> tangent(n);
+	std::valarray<double> point(n);
+	std::valarray<double> perturbedValues(n);
+
+	for(int k = 1; k < numParameters; k++)
+	{
+		while(parameter != myParameters[k])
+		{
+			//A step size of 0 would never reach the next value
+			double minStep = std::max(myMinStep, std::numeric_limits<double>::epsilon()*(1.0 + std::abs(parameter)));
+
+			//The last step lands exactly on the parameter value
+			double remaining = myParameters[k] - parameter;
+			double nextParameter = (std::abs(remaining) <= stepSize) ? myParameters[k] : parameter + std::copysign(stepSize, remaining);
+			double step = nextParameter - parameter;
+			//Until the first adaptation the step size is unbounded, the step taken is then the one to adapt from
+			double currentStepSize = std::isinf(stepSize) ? std::abs(step) : stepSize;
+
+			arma::Col<double> guess = solution;
+			bool predicted = false;
+			if(myPredictor == TANGENT)
+			{
+				for(arma::uword i = 0; i < n; i++)
+				{
+					point[i] = solution[i];
+				}
+				double parameterProbe = std::sqrt(std::numeric_limits<double>::epsilon())*(1.0 + std::abs(parameter));
+				myModelFamily(parameter + parameterProbe)(point, perturbedValues);
+				arma::Col<double> parameterDerivative(n);
+				for(arma::uword i = 0; i < n; i++)
+				{
+					parameterDerivative[i] = (perturbedValues[i] - solutionValues[i])/parameterProbe;
+				}
+				if(not jacobian.is_empty() and myLinearSolver(jacobian, -parameterDerivative, tangent))
+				{
+					guess = solution + step*tangent;
+					predicted = true;
+				}
+			}
+			if(not predicted and havePrevious)
+			{
+				guess = solution + (step/(parameter - previousParameter))*(solution - previousSolution);
+			}
+
+			Solver solver(myModelFamily(nextParameter), myMaxIterations, myErrorTolerance, myJacobianPolicy, myLinearSolver);
+			NewtonResult stepResult = solver.solve(guess, myTargets);
+			result.totalIterations += stepResult.iterations;
+
+			if(not stepResult.converged)
+			{
+				result.numRejectedSteps++;
+				stepSize = 0.5*currentStepSize;
+				if(stepSize < minStep)
+				{
+					return result;
+				}
+				continue;
+			}
+
+			result.numSteps++;
+			havePrevious = true;
+			previousParameter = parameter;
+			previousSolution = solution;
+			parameter = nextParameter;
+			solution = guess;
+			solutionValues = solver.values();
+			//A prediction that needed no correction keeps the Jacobian of the last corrector that iterated
+			if(stepResult.iterations > 0)
+			{
+				jacobian = solver.jacobian();
+			}
+			myResults[k] = stepResult;
+
+			if(stepResult.iterations < myTargetIterations)
+			{
+				stepSize = 2.0*currentStepSize;
+			}
+			else if(stepResult.iterations > myTargetIterations)
+			{
+				stepSize = std::max(0.5*currentStepSize, minStep);
+			}
+		}
+		mySolutions.col(k) = solution;
+	}
+
+	result.completed = true;
+	return result;
+}
+
+#endif
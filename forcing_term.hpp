@@ -0,0 +1,81 @@
+/*
+####Title:
+Eisenstat-Walker Forcing Terms for Inexact Newton
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+When the Newton step J*v = -F(x) is solved iteratively (GMRES, BiCGStab), it does not need to be solved to full
+precision while F(x) is still large: the linear model J*v ~= -F(x) is only a rough picture of the model there, and
+every Krylov iteration spent beyond that is wasted. Inexact Newton accepts any step with
+||F(x) + J*v|| <= eta*||F(x)||, where eta, the forcing term, is the relative tolerance handed to the Krylov solver.
+
+EisenstatWalkerForcingTerm chooses eta per Newton step from how fast the residual error is dropping
+(Eisenstat and Walker, choice 2):
+
+eta_k = gamma * (||F(x_k)|| / ||F(x_(k-1))||)^alpha
+
+While the residual drops slowly, eta stays loose; once Newton converges fast, eta tightens with it so the
+quadratic convergence is kept. Two safeguards follow Kelley:
+-if gamma*eta_(k-1)^alpha > 0.1, eta_k is kept at least that large, so a single good step does not make eta drop
+ sharply
+-eta_k is at least 0.5*errorTolerance/||F(x_k)||, a linear solve tighter than the nonlinear tolerance needs is
+ oversolving on the last step
+and eta is always at most maxForcingTerm. The first step uses initialForcingTerm.
+*/
+
+#ifndef FORCING_TERM_HPP
+#define FORCING_TERM_HPP
+
+#include <algorithm>
+#include <cmath>
+
+class EisenstatWalkerForcingTerm
+{
+public:
+	EisenstatWalkerForcingTerm(double initialForcingTerm, double maxForcingTerm, double gamma = 0.9, double alpha = 2.0)
+		: myInitialForcingTerm(initialForcingTerm), myMaxForcingTerm(maxForcingTerm), myGamma(gamma), myAlpha(alpha),
+		  myForcingTerm(initialForcingTerm), myPreviousError(0.0), myHasPreviousError(false)
+	{
+	}
+
+	double forcingTerm() const
+	{
+		return myForcingTerm;
+	}
+
+	//Relative tolerance for the linear solve of the step from a guess whose residual error is error
+	double next(double error, double errorTolerance)
+	{
+		double forcingTerm = myInitialForcingTerm;
+		if(myHasPreviousError and myPreviousError > 0.0)
+		{
+			forcingTerm = myGamma*std::pow(error/myPreviousError, myAlpha);
+			double safeguard = myGamma*std::pow(myForcingTerm, myAlpha);
+			if(safeguard > 0.1)
+			{
+				forcingTerm = std::max(forcingTerm, safeguard);
+			}
+			if(error > 0.0)
+			{
+				forcingTerm = std::max(forcingTerm, 0.5*errorTolerance/error);
+			}
+		}
+		myForcingTerm = std::min(forcingTerm, myMaxForcingTerm);
+		myPreviousError = error;
+		myHasPreviousError = true;
+		return myForcingTerm;
+	}
+
+private:
+	double myInitialForcingTerm;
+	double myMaxForcingTerm;
+	double myGamma;
+	double myAlpha;
+	double myForcingTerm;
+	double myPreviousError;
+	bool myHasPreviousError;
+};
+
+#endif
@@ -30,6 +30,29 @@ The method "calculateJacobian" demonstrates the forward-difference technique:
 w.r.t the perturbed dof
 4)The calculated derivatives are a column of the Jacobian matrix.
 
+"calculateJacobianColumn" holds the difference formula shared by the serial and parallel Jacobians.
+DIFFERENCESCHEME selects it:
+-FORWARDDIFFERENCE: (F(x+h) - F(x)) / h, one extra evaluation per column, error O(h)
+-CENTRALDIFFERENCE: (F(x+h) - F(x-h)) / 2h, two extra evaluations per column, error O(h^2)
+-RICHARDSON: Richardson extrapolation of the forward differences with steps h and h/2,
+ 2*D(h/2) - D(h) = (4*F(x+h/2) - F(x+h) - 3*F(x)) / h, two extra evaluations per column, error O(h^2)
+The forward and Richardson formulas reuse the unperturbed evaluation F(x) the Jacobian computes anyway,
+and every scheme hands it back as targetsCalculated.
+
+With USEADAPTIVEPROBEDISTANCE the fixed PROBEDISTANCE is replaced with a step chosen for each column from the size
+of the variable and the relative noise in the model evaluation, eps_F (machine precision for a model computed in
+double precision, more for models with iterative solvers or tabulated data inside):
+h = eps_F^(1/(p+1)) * max(|x_j|, 1)
+where p is the order of the scheme, which balances truncation error against the noise amplified by 1/h.
+The step is rounded so that x_j + h is exactly representable, so the perturbation really is h.
+eps_F is not assumed but estimated once, at the initial guess, by "estimateFunctionNoise" (the ECnoise method of
+More and Wild): the model is evaluated at NUMNOISEPOINTS points NOISESPACING apart along a fixed direction, and
+the difference table of every equation is built from them. The k-th differences of a smooth function shrink
+like NOISESPACING^k, while those of noise with standard deviation sigma keep a mean square of sigma^2/gamma_k,
+gamma_k = (k!)^2/(2k)!. The first order whose estimate sqrt(gamma_k * mean square) agrees within a factor 4 with
+the next two, and whose differences change sign, gives sigma. eps_F is the largest sigma relative to the size
+of its equation's values, and never less than FUNCTIONNOISE.
+
 The Jacobian matrix looks like this:
 dE1/dx | dE1/dy | dE1/dz
 ------------------------
@@ -47,6 +70,65 @@ The Newton Raphson scheme works like this:
 7)Loop back to step 1 and carry out subsequent steps until equations_results_from_guess_current is close to your target as desired
 --or-- the maximum number of iterations allowable has been exceeded according to your criteria.
 
+The method "calculateParallelJacobian" fills the same columns on the worker threads of a ThreadPool (thread_pool.hpp).
+Every worker perturbs its own copy of the guess and evaluates the model into its own buffer, so no two threads
+ever touch the same data; each column of the Jacobian is written by exactly one worker.
+It is off by default: for a model as cheap as this one, handing out a few columns costs more than it saves.
+Set USEPARALLELJACOBIAN to true for expensive models with many unknowns; the serial "calculateJacobian" is used otherwise.
+
+The model reaches the Jacobian functions as any callable, a lambda or function object, through a template
+parameter rather than a function pointer. The callable carries the model's parameters (the offsets here), and
+since its type is known at compile time the model can be inlined into the perturbation loop; for a model as cheap
+as this one an indirect call per evaluation would cost more than the evaluation itself.
+
+Set USEJACOBIANFREE to true to skip the Jacobian altogether (Jacobian-free Newton-Krylov):
+"updateGuessJacobianFree" solves step 5 with GMRES (krylov_solvers.hpp), which only needs products of the Jacobian
+with a vector v. Each product is a single forward-difference probe along v:
+Jacobian * v ~= (F(x + h*v) - F(x)) / h
+so no NUMDIMENSIONS x NUMDIMENSIONS matrix is ever stored or factored.
+With USEINEXACTNEWTON, GMRES is only asked for the relative tolerance that the Eisenstat-Walker forcing term
+(forcing_term.hpp) derives from how fast the residual error is dropping, instead of KRYLOVTOLERANCE on every step.
+The GMRES iterations of every step are printed, and their total at the end.
+
+Set USEBROYDENUPDATES to true to compute the Jacobian only once and then correct it with the "good" Broyden
+rank-one update after every step (broyden_update.hpp). "updateGuessBroyden" reuses the stored LU factors of the last
+Jacobian, so an iteration costs one model evaluation and O(NUMDIMENSIONS^2) work. A fresh Jacobian is computed
+after MAXBROYDENUPDATES updates.
+
+Set USEMODIFIEDNEWTON to true to keep the LU factors of the Jacobian across iterations (lu_factorization.hpp).
+"updateGuessModifiedNewton" then only does two triangular solves per step; the Jacobian is recomputed and refactored
+after MAXFACTORIZATIONREUSES steps, or as soon as a step reduces the residual error by less than MAXRESIDUALRATIO.
+
+Set USEMIXEDPRECISION to true to have "updateGuess" factor the Jacobian in single precision and recover the
+double-precision step by iterative refinement against the same right hand side (mixed_precision_solver.hpp).
+
+Set USELINESEARCH to true to have every step checked against the Armijo sufficient decrease condition on the residual error
+and shortened by backtracking if it fails (line_search.hpp). The full step is evaluated as usual, so the line
+search only costs model evaluations when that step is rejected; the number it spends is printed at the end.
+It is not combined with Broyden updates, which have already been corrected with the full step.
+
+Set USETRUSTREGION to true to globalize with a trust region instead: "updateGuessTrustRegion" takes the Powell
+dogleg step (trust_region.hpp) within the current radius, from the Jacobian already computed for the iteration.
+The ratio of the actual to the predicted reduction of the residual then decides whether the step is kept and
+how the radius changes. A rejected step costs one model evaluation; the guess stays and the same Jacobian is
+used again with the smaller radius.
+
+Set USETARGETSWEEP to true to also solve F(x) = t for NUMSWEEPTARGETS targets t between SWEEPSTART and SWEEPEND
+after the main loop. "solveTargetSweep" iterates all of them together. Every iteration groups the targets not yet
+converged by how close their guesses are (within SWEEPGROUPRADIUS of the first guess of the group), computes and
+factors one Jacobian at that first guess, and solves the Newton steps of the whole group as one block of right hand
+sides (LUFactorization::solveMultiple), so the factorization and the pass over its factors are shared. Guesses
+that start together share every Jacobian; once they spread apart each target gets its own Jacobian and converges
+quadratically instead of stalling on a Jacobian taken far from its guess. Each target's convergence is reported.
+Only this example has the sweep; complex_step.cpp and automatic_differentiation.cpp solve the single target.
+
+Which modes combine: USEJACOBIANFREE, USEBROYDENUPDATES, USEMODIFIEDNEWTON and USETRUSTREGION each replace the plain
+Newton step and exclude each other. USEMIXEDPRECISION only changes the plain step, so it is used with none of them.
+USELINESEARCH shortens the plain, Jacobian-free or modified Newton step, but not a Broyden step, which has already
+been corrected with the full step, nor a trust region step, which limits itself. USEINEXACTNEWTON only affects the
+Jacobian-free step. Any other combination would silently drop one of the modes, so the static_asserts after the
+constants reject it at compile time.
+
 ####Dependencies:
 The "Armadillo" C++ API was chosen to handle the linear algebra tasks because of its clear syntax
 and integration with LAPACK. For a list of dependences and installation instructions for
@@ -55,8 +137,23 @@ Armadillo refer to the Armadillo project page at sourceforge.net.
 As of 20 Aug. 2013, Armadillo can be obtained at: http://arma.sourceforge.net/
 */
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
 #include <armadillo>
+#include "broyden_update.hpp"
+#include "forcing_term.hpp"
+#include "krylov_solvers.hpp"
+#include "line_search.hpp"
+#include "lu_factorization.hpp"
+#include "mixed_precision_solver.hpp"
+#include "small_linear_solver.hpp"
+#include "thread_pool.hpp"
+#include "trust_region.hpp"
 
 const int NUMDIMENSIONS = 3;
 const int MAXITERATIONS = 9;
@@ -64,34 +161,129 @@ const double ERRORTOLLERANCE = 1.0E-4;
 //If probe distance is made too small, subtractive cancellation may occur, leading to inaccurate derivatives
 //recompile with a small value for PROBEDISTANCE, like 1.0E-30 to see the effect
 const double PROBEDISTANCE = 1.0E-10;
+enum DifferenceScheme {FORWARDDIFFERENCE, CENTRALDIFFERENCE, RICHARDSON};
+const DifferenceScheme DIFFERENCESCHEME = FORWARDDIFFERENCE;
+const bool USEADAPTIVEPROBEDISTANCE = false;
+//Lower bound of the estimated relative noise, the rounding error of a model computed in double precision
+const double FUNCTIONNOISE = std::numeric_limits<double>::epsilon();
+const int NUMNOISEPOINTS = 8;
+//Relative to the size of the guess; small enough that the model is smooth across all the points
+const double NOISESPACING = 1.0E-6;
+const bool USEPARALLELJACOBIAN = false;
+const int NUMTHREADS = 4;
+const bool USEJACOBIANFREE = false;
+const int MAXKRYLOVITERATIONS = 30;
+const int KRYLOVRESTART = 10;
+const double KRYLOVTOLERANCE = 1.0E-6;
+//GMRES needs consistent products from one iteration to the next, so the directional probe uses roughly
+//the square root of machine precision, which balances truncation against cancellation error
+const double KRYLOVPROBEDISTANCE = 1.0E-7;
+const bool USEINEXACTNEWTON = false;
+const double INITIALFORCINGTERM = 0.5;
+const double MAXFORCINGTERM = 0.9;
+const bool USEBROYDENUPDATES = false;
+const int MAXBROYDENUPDATES = 10;
+const bool USEMODIFIEDNEWTON = false;
+const int MAXFACTORIZATIONREUSES = 5;
+const double MAXRESIDUALRATIO = 0.5;
+const bool USEMIXEDPRECISION = false;
+const int MAXREFINEMENTS = 5;
+const double REFINEMENTTOLERANCE = 1.0E-14;
+const bool USETARGETSWEEP = false;
+const int NUMSWEEPTARGETS = 8;
+//The sweep solves F(x) = (0, t, 0), whose root (1, sqrt(t/2), -t/2) is regular for every t > 0
+const double SWEEPSTART = 0.5;
+const double SWEEPEND = 1.0;
+//Targets whose guesses lie within this distance of a seed guess, relative to its size, share the seed's Jacobian
+const double SWEEPGROUPRADIUS = 1.0E-2;
+const bool USELINESEARCH = false;
+//Armijo constant: a step must reduce the residual error by at least this fraction of its length
+const double SUFFICIENTDECREASE = 1.0E-4;
+const int MAXBACKTRACKS = 10;
+const bool USETRUSTREGION = false;
+const double INITIALTRUSTRADIUS = 1.0;
+const double MAXTRUSTRADIUS = 100.0;
+
+static_assert(int(USEJACOBIANFREE) + int(USEBROYDENUPDATES) + int(USEMODIFIEDNEWTON) + int(USETRUSTREGION) <= 1,
+	      "USEJACOBIANFREE, USEBROYDENUPDATES, USEMODIFIEDNEWTON and USETRUSTREGION exclude each other");
+static_assert(not USEMIXEDPRECISION or not (USEJACOBIANFREE or USEBROYDENUPDATES or USEMODIFIEDNEWTON or USETRUSTREGION),
+	      "USEMIXEDPRECISION only applies to the plain Newton step");
+static_assert(not USELINESEARCH or not (USEBROYDENUPDATES or USETRUSTREGION),
+	      "USELINESEARCH cannot be combined with USEBROYDENUPDATES or USETRUSTREGION");
 
 void calculateDependentVariables(const arma::Mat<double>& myOffsets,
 				 const arma::Col<double>& myCurrentGuess, 
 		                 arma::Col<double>& targetsCalculated);
 
-void calculateJacobian(const arma::Mat<double>& myOffsets,
-			arma::Mat<double>& myJacobian, 
+template <class Model>
+double estimateFunctionNoise(const arma::Col<double>& myCurrentGuess,
+			     const Model& myCalculateDependentVariables);
+
+double calculateProbeDistance(double myGuessValue,
+			      double myFunctionNoise);
+
+template <class Model>
+void calculateJacobianColumn(int myColumn,
+			     arma::Mat<double>& myJacobian,
+			     const arma::Col<double>& myUnperturbedTargetsCalculated,
+			     arma::Col<double>& myPerturbedGuess,
+			     arma::Col<double>& myPerturbedTargetsCalculated,
+			     arma::Col<double>& mySecondPerturbedTargetsCalculated,
+			     double myFunctionNoise,
+			     const Model& myCalculateDependentVariables);
+
+template <class Model>
+void calculateJacobian(arma::Mat<double>& myJacobian, 
 		       arma::Col<double>& myTargetsCalculated, 
 		       arma::Col<double>& myCurrentGuess, 
-		       void myCalculateDependentVariables(const arma::Mat<double>&, const arma::Col<double>&, arma::Col<double>&));
+		       double myFunctionNoise,
+		       const Model& myCalculateDependentVariables);
+
+template <class Model>
+void calculateParallelJacobian(arma::Mat<double>& myJacobian,
+			       arma::Col<double>& myTargetsCalculated,
+			       const arma::Col<double>& myCurrentGuess,
+			       ThreadPool& myThreadPool,
+			       double myFunctionNoise,
+			       const Model& myCalculateDependentVariables);
 
 void updateGuess(arma::Col<double>& myCurrentGuess,
 		 const arma::Col<double>& myTargetsCalculated,
 		 const arma::Mat<double>& myJacobian);
 
+template <class Model>
+int updateGuessJacobianFree(arma::Col<double>& myCurrentGuess,
+			    const arma::Col<double>& myTargetsCalculated,
+			    EisenstatWalkerForcingTerm& myForcingTerm,
+			    const Model& myCalculateDependentVariables);
+
+void updateGuessBroyden(arma::Col<double>& myCurrentGuess,
+			const arma::Col<double>& myTargetsCalculated,
+			BroydenUpdate& myBroydenUpdate);
+
+void updateGuessModifiedNewton(arma::Col<double>& myCurrentGuess,
+			       const arma::Col<double>& myTargetsCalculated,
+			       const LUFactorization& myFactorization,
+			       const FactorizationReusePolicy& myReusePolicy);
+
+void updateGuessTrustRegion(arma::Col<double>& myCurrentGuess,
+			    const arma::Col<double>& myTargetsDesired,
+			    const arma::Col<double>& myTargetsCalculated,
+			    const arma::Mat<double>& myJacobian,
+			    DoglegTrustRegion& myTrustRegion);
+
+template <class Model>
+void solveTargetSweep(const arma::Mat<double>& mySweepTargets,
+		      arma::Mat<double>& mySweepGuesses,
+		      double myFunctionNoise,
+		      const Model& myCalculateDependentVariables);
+
 void calculateResidual(const arma::Col<double>& myTargetsDesired, 
 		       const arma::Col<double>& myTargetsCalculated,
 		       double& myError);
 
 int main(int argc, char* argv[])
 {
-	//--This first declaration is included for software engineering reasons: allow main method to control flow of data
-	//create function pointer for calculateDependentVariable
-	//We want to do this so that calculateJacobian can call calculateDependentVariables as it needs to,
-	//but we explicitly give it this authority from the main method
-	void (*yourCalculateDependentVariables)(const arma::Mat<double>&, const arma::Col<double>&, arma::Col<double>&);
-	yourCalculateDependentVariables = &calculateDependentVariables;
-
 	//The problem being solved is to find the intersection of three infinite paraboloids:
 	//(x-1)^2 + y^2 + z = 0
 	//x^2 + y^2 -(z+1) = 0
@@ -104,6 +296,17 @@ int main(int argc, char* argv[])
 	offsets.col(2)[1] = 1.0;
 	offsets.col(2)[2] = 1.0;
 
+	//--This declaration is included for software engineering reasons: allow main method to control flow of data
+	//create a callable for calculateDependentVariables that carries the offsets with it
+	//We want to do this so that calculateJacobian can call calculateDependentVariables as it needs to,
+	//but we explicitly give it this authority from the main method
+	//The Jacobian functions take the callable's type as a template parameter, so unlike a function pointer
+	//the model can be inlined into their perturbation loops
+	auto yourCalculateDependentVariables = [&offsets](const arma::Col<double>& myCurrentGuess, arma::Col<double>& myTargetsCalculated)
+	{
+		calculateDependentVariables(offsets, myCurrentGuess, myTargetsCalculated);
+	};
+
 	//We need to initialize the target vectors and provide an initial guess
 	arma::Col<double> targetsDesired(NUMDIMENSIONS);
 	targetsDesired.fill(0.0);
@@ -117,41 +320,222 @@ int main(int argc, char* argv[])
 	arma::Col<double> guessChange(NUMDIMENSIONS);
 	guessChange.fill(0.0);
 
+	//The guess before the step, the line search shortens the step back towards it
+	arma::Col<double> previousGuess(NUMDIMENSIONS);
+	previousGuess.fill(0.0);
+	BacktrackingLineSearch lineSearch(SUFFICIENTDECREASE, MAXBACKTRACKS);
+	int lineSearchEvaluations = 0;
+
+	//A rejected trust region step goes back to the guess before it and its F(x)
+	arma::Col<double> previousTargetsCalculated(NUMDIMENSIONS);
+	previousTargetsCalculated.fill(0.0);
+	DoglegTrustRegion trustRegion(INITIALTRUSTRADIUS, MAXTRUSTRADIUS);
+
 	//Place to store our tangent-stiffness matrix or Jacobian
 	//One element for every combination of dependent variable with independent variable
 	arma::Mat<double> jacobian(NUMDIMENSIONS, NUMDIMENSIONS);
 	jacobian.fill(0.0);
 
+	//The worker threads are created once here and reused by every Jacobian, none are started for the serial one
+	std::unique_ptr<ThreadPool> threadPool;
+	if(USEPARALLELJACOBIAN)
+	{
+		threadPool.reset(new ThreadPool(NUMTHREADS));
+	}
+
+	//Relative tolerance of every Jacobian-free Newton step, and the GMRES iterations they took
+	EisenstatWalkerForcingTerm forcingTerm(INITIALFORCINGTERM, MAXFORCINGTERM);
+	int krylovIterations = 0;
+
+	//Factors of the last Jacobian and the Broyden updates applied since
+	BroydenUpdate broydenUpdate(MAXBROYDENUPDATES);
+
+	//Factors of the last Jacobian for modified Newton, and when to refresh them
+	LUFactorization factorization;
+	FactorizationReusePolicy reusePolicy(MAXFACTORIZATIONREUSES, MAXRESIDUALRATIO);
+
 	int count = 0;
 	double error = 1.0E5;
+	double previousError = error;
 
 	std::cout << "Running forward difference example ..........." << std::endl;
+
+	//The relative noise in the model that the adaptive probe distances are balanced against
+	double functionNoise = FUNCTIONNOISE;
+	if(USEADAPTIVEPROBEDISTANCE)
+	{
+		functionNoise = estimateFunctionNoise(currentGuess, yourCalculateDependentVariables);
+		std::cout << "Estimated relative function noise: " << functionNoise << std::endl;
+	}
+
+	//The Jacobian-free step has no Jacobian function to evaluate F at the initial guess,
+	//every later one comes from the end of the iteration before
+	if(USEJACOBIANFREE)
+	{
+		yourCalculateDependentVariables(currentGuess, targetsCalculated);
+	}
+
 	while(count < MAXITERATIONS and error > ERRORTOLLERANCE)
 	{
+		previousGuess = currentGuess;
 
-		//Calculate Jacobian tangent to currentGuess point
-		//at the same time, an unperturbed targetsCalculated is, well, calculated
-		calculateJacobian(offsets,
-				  jacobian,
-				  targetsCalculated,
-				  currentGuess,
-                                  yourCalculateDependentVariables);
+		if(USEJACOBIANFREE)
+		{
+			//Compute a new currentGuess from Jacobian-vector products only
+			krylovIterations += updateGuessJacobianFree(currentGuess,
+								    targetsCalculated,
+								    forcingTerm,
+								    yourCalculateDependentVariables);
+		}
+		else
+		{
+			//With Broyden updates or modified Newton the Jacobian is only recomputed when the old one is used up,
+			//in a trust region only after a step was accepted
+			bool needsJacobian = true;
+			if(USEBROYDENUPDATES)
+			{
+				needsJacobian = broydenUpdate.needsJacobian();
+			}
+			else if(USEMODIFIEDNEWTON)
+			{
+				needsJacobian = reusePolicy.needsRefresh();
+			}
+			else if(USETRUSTREGION)
+			{
+				needsJacobian = trustRegion.needsJacobian();
+			}
+
+			if(needsJacobian)
+			{
+				//Calculate Jacobian tangent to currentGuess point
+				//at the same time, an unperturbed targetsCalculated is, well, calculated
+				if(USEPARALLELJACOBIAN)
+				{
+					calculateParallelJacobian(jacobian,
+								  targetsCalculated,
+								  currentGuess,
+								  *threadPool,
+								  functionNoise,
+								  yourCalculateDependentVariables);
+				}
+				else
+				{
+					calculateJacobian(jacobian,
+							  targetsCalculated,
+							  currentGuess,
+							  functionNoise,
+							  yourCalculateDependentVariables);
+				}
+
+				if(USEBROYDENUPDATES)
+				{
+					//Singular factors are not kept: updateGuessBroyden skips the step and, since needsJacobian
+					//stays true, the next iteration tries a fresh Jacobian again
+					broydenUpdate.reset(jacobian);
+				}
+				else if(USEMODIFIEDNEWTON)
+				{
+					//Singular factors are not kept, the next iteration tries a fresh Jacobian again
+					if(factorization.factor(jacobian))
+					{
+						reusePolicy.refreshed();
+					}
+					else
+					{
+						reusePolicy.invalidate();
+					}
+				}
+			}
 
-		//Compute a new currentGuess
-		updateGuess(currentGuess,
-			    targetsCalculated,
-			    jacobian);
+			//Compute a new currentGuess
+			if(USEBROYDENUPDATES)
+			{
+				updateGuessBroyden(currentGuess,
+						   targetsCalculated,
+						   broydenUpdate);
+			}
+			else if(USEMODIFIEDNEWTON)
+			{
+				updateGuessModifiedNewton(currentGuess,
+							  targetsCalculated,
+							  factorization,
+							  reusePolicy);
+			}
+			else if(USETRUSTREGION)
+			{
+				updateGuessTrustRegion(currentGuess,
+						       targetsDesired,
+						       targetsCalculated,
+						       jacobian,
+						       trustRegion);
+			}
+			else
+			{
+				updateGuess(currentGuess,
+					    targetsCalculated,
+					    jacobian);
+			}
+		}
+
+		//targetsCalculated still holds F(x) of the guess before the step, so its error costs no model evaluation
+		calculateResidual(targetsDesired,
+				  targetsCalculated,
+				  previousError);
+		previousTargetsCalculated = targetsCalculated;
 
 		//Compute F(x) with the updated, currentGuess
 		calculateDependentVariables(offsets,
 				            currentGuess,
 			       		    targetsCalculated);	
 
+		//The step just taken and the change in F(x) it caused update the approximate Jacobian
+		if(USEBROYDENUPDATES and not USEJACOBIANFREE)
+		{
+			broydenUpdate.update(targetsCalculated);
+		}
+
 		//Calculate the L2 norm of Ftarget - F(xCurrentGuess)
 		calculateResidual(targetsDesired,
 			          targetsCalculated,
 			  	  error);	  
 
+		//Shorten the step if the full one did not reduce the error enough
+		//Not with Broyden updates, which have already been corrected with the full step,
+		//nor in a trust region, which limits the step itself
+		if(USELINESEARCH and not USEBROYDENUPDATES and not USETRUSTREGION)
+		{
+			int evaluations = lineSearch.search(yourCalculateDependentVariables,
+							    previousGuess,
+							    previousError,
+							    targetsDesired,
+							    currentGuess,
+							    targetsCalculated,
+							    error);
+			if(evaluations > 0)
+			{
+				std::cout << "Line search backtracks: " << evaluations << std::endl;
+			}
+			lineSearchEvaluations += evaluations;
+		}
+
+		//Keep a trust region step only if the error dropped by a fair share of what the linear model predicted
+		if(USETRUSTREGION and not USEBROYDENUPDATES and not USEMODIFIEDNEWTON and not USEJACOBIANFREE)
+		{
+			if(not trustRegion.update(previousError, error))
+			{
+				std::cout << "Trust region step rejected" << std::endl;
+				currentGuess = previousGuess;
+				targetsCalculated = previousTargetsCalculated;
+				error = previousError;
+			}
+		}
+
+		//A step that barely reduced the error means the stored factors are too far off
+		if(USEMODIFIEDNEWTON and not USEBROYDENUPDATES and not USEJACOBIANFREE)
+		{
+			reusePolicy.recordStep(previousError, error);
+		}
+
 		count ++;
 		//If we have converged, or if we have exceeded our alloted number of iterations, discontinue the loop
 		std::cout << "Residual Error: " << error << std::endl;
@@ -162,6 +546,35 @@ int main(int argc, char* argv[])
 	std::cout << "Final guess:\nx, y, z\n " << currentGuess.t();
 	std::cout << "Error tollerance: " << ERRORTOLLERANCE << std::endl;
 	std::cout << "Final error: " << error << std::endl;
+	if(USEJACOBIANFREE)
+	{
+		std::cout << "Total GMRES iterations: " << krylovIterations << std::endl;
+	}
+	if(USELINESEARCH and not USETRUSTREGION)
+	{
+		std::cout << "Extra model evaluations in the line search: " << lineSearchEvaluations << std::endl;
+	}
+
+	if(USETARGETSWEEP)
+	{
+		//Every target of the sweep starts from the same initial guess as the main loop
+		arma::Mat<double> sweepTargets(NUMDIMENSIONS, NUMSWEEPTARGETS);
+		sweepTargets.fill(0.0);
+		for(int k = 0; k < NUMSWEEPTARGETS; k++)
+		{
+			sweepTargets(1, k) = SWEEPSTART + (SWEEPEND - SWEEPSTART)*k/std::max(NUMSWEEPTARGETS - 1, 1);
+		}
+		arma::Mat<double> sweepGuesses(NUMDIMENSIONS, NUMSWEEPTARGETS);
+		sweepGuesses.fill(2.0);
+
+		std::cout << "Running target sweep ..........." << std::endl;
+		solveTargetSweep(sweepTargets,
+				 sweepGuesses,
+				 functionNoise,
+				 yourCalculateDependentVariables);
+		std::cout << "Sweep targets:\n" << sweepTargets;
+		std::cout << "Sweep solutions:\n" << sweepGuesses;
+	}
 	std::cout << "--program complete--" << std::endl;
 
 	return 0;
@@ -187,18 +600,158 @@ void calculateDependentVariables(const arma::Mat<double>& myOffsets,
 	
 }
 
-void calculateJacobian(const arma::Mat<double>& myOffsets,
-		       arma::Mat<double>& myJacobian, 
+template <class Model>
+double estimateFunctionNoise(const arma::Col<double>& myCurrentGuess,
+			     const Model& myCalculateDependentVariables)
+{
+	//A fixed pseudo-random direction, so that no sample is special for the model (e.g. exactly representable)
+	std::mt19937 generator(1);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	arma::Col<double> direction(NUMDIMENSIONS);
+	double guessSize = 1.0;
+	for(int j = 0; j < NUMDIMENSIONS; j++)
+	{
+		direction[j] = distribution(generator);
+		guessSize = std::max(guessSize, std::fabs(myCurrentGuess[j]));
+	}
+	double spacing = NOISESPACING*guessSize;
+
+	//F(x + k*spacing*direction), one column per sample
+	arma::Mat<double> samples(NUMDIMENSIONS, NUMNOISEPOINTS);
+	arma::Col<double> samplePoint(NUMDIMENSIONS);
+	arma::Col<double> sampleTargetsCalculated(NUMDIMENSIONS);
+	for(int k = 0; k < NUMNOISEPOINTS; k++)
+	{
+		samplePoint = myCurrentGuess + (k*spacing)*direction;
+		myCalculateDependentVariables(samplePoint, sampleTargetsCalculated);
+		samples.col(k) = sampleTargetsCalculated;
+	}
+
+	double relativeNoise = 0.0;
+	std::vector<double> differences(NUMNOISEPOINTS);
+	std::vector<double> estimates(NUMNOISEPOINTS, 0.0);
+	std::vector<bool> changesSign(NUMNOISEPOINTS, false);
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		double valueSize = 0.0;
+		for(int k = 0; k < NUMNOISEPOINTS; k++)
+		{
+			differences[k] = samples(i, k);
+			valueSize = std::max(valueSize, std::fabs(samples(i, k)));
+		}
+
+		//Order k of the difference table, built in place, with the noise level each order suggests
+		double gamma = 1.0;
+		for(int k = 1; k < NUMNOISEPOINTS; k++)
+		{
+			double meanSquare = 0.0;
+			double smallest = std::numeric_limits<double>::infinity();
+			double largest = -std::numeric_limits<double>::infinity();
+			for(int l = 0; l < NUMNOISEPOINTS - k; l++)
+			{
+				differences[l] = differences[l + 1] - differences[l];
+				meanSquare += differences[l]*differences[l];
+				smallest = std::min(smallest, differences[l]);
+				largest = std::max(largest, differences[l]);
+			}
+			meanSquare /= double(NUMNOISEPOINTS - k);
+			//gamma_k = (k!)^2/(2k)!
+			gamma *= 0.5*k/(2.0*k - 1.0);
+			estimates[k] = std::sqrt(gamma*meanSquare);
+			changesSign[k] = smallest < 0.0 and largest > 0.0;
+		}
+
+		//An equation without a consistent estimate, e.g. evaluated exactly, adds no noise
+		for(int k = 1; k + 2 < NUMNOISEPOINTS; k++)
+		{
+			double lowest = std::min(estimates[k], std::min(estimates[k + 1], estimates[k + 2]));
+			double highest = std::max(estimates[k], std::max(estimates[k + 1], estimates[k + 2]));
+			if(changesSign[k] and lowest > 0.0 and highest <= 4.0*lowest)
+			{
+				if(valueSize > 0.0)
+				{
+					relativeNoise = std::max(relativeNoise, estimates[k]/valueSize);
+				}
+				break;
+			}
+		}
+	}
+
+	return std::max(relativeNoise, FUNCTIONNOISE);
+}
+
+double calculateProbeDistance(double myGuessValue,
+			      double myFunctionNoise)
+{
+	if(not USEADAPTIVEPROBEDISTANCE)
+	{
+		return PROBEDISTANCE;
+	}
+
+	//Balance truncation error, O(h^order), against noise error, O(myFunctionNoise/h)
+	double order = (DIFFERENCESCHEME == FORWARDDIFFERENCE) ? 1.0 : 2.0;
+	double probeDistance = std::pow(myFunctionNoise, 1.0/(order + 1.0)) * std::max(std::fabs(myGuessValue), 1.0);
+
+	//Round so that (x + h) - x == h exactly, volatile keeps the compiler from simplifying it away
+	volatile double perturbedGuessValue = myGuessValue + probeDistance;
+	return perturbedGuessValue - myGuessValue;
+}
+
+template <class Model>
+void calculateJacobianColumn(int myColumn,
+			     arma::Mat<double>& myJacobian,
+			     const arma::Col<double>& myUnperturbedTargetsCalculated,
+			     arma::Col<double>& myPerturbedGuess,
+			     arma::Col<double>& myPerturbedTargetsCalculated,
+			     arma::Col<double>& mySecondPerturbedTargetsCalculated,
+			     double myFunctionNoise,
+			     const Model& myCalculateDependentVariables)
+{
+	//Store old element value, it is restored once the column is filled
+	double oldGuessValue = myPerturbedGuess[myColumn];
+	double probeDistance = calculateProbeDistance(oldGuessValue, myFunctionNoise);
+
+	//Evaluate functions for the guess perturbed forward by h
+	myPerturbedGuess[myColumn] = oldGuessValue + probeDistance;
+	myCalculateDependentVariables(myPerturbedGuess, myPerturbedTargetsCalculated);
+
+	if(DIFFERENCESCHEME == CENTRALDIFFERENCE)
+	{
+		//and backward by h
+		myPerturbedGuess[myColumn] = oldGuessValue - probeDistance;
+		myCalculateDependentVariables(myPerturbedGuess, mySecondPerturbedTargetsCalculated);
+		myJacobian.col(myColumn) = (myPerturbedTargetsCalculated - mySecondPerturbedTargetsCalculated) * pow(2.0*probeDistance, -1.0);
+	}
+	else if(DIFFERENCESCHEME == RICHARDSON)
+	{
+		//and forward by h/2, the O(h) errors of the two forward differences cancel in 2*D(h/2) - D(h)
+		myPerturbedGuess[myColumn] = oldGuessValue + 0.5*probeDistance;
+		myCalculateDependentVariables(myPerturbedGuess, mySecondPerturbedTargetsCalculated);
+		myJacobian.col(myColumn) = (4.0*mySecondPerturbedTargetsCalculated - myPerturbedTargetsCalculated - 3.0*myUnperturbedTargetsCalculated) * pow(probeDistance, -1.0);
+	}
+	else
+	{
+		//The arma::Col allows this to be expressed as a single vector operation
+		myJacobian.col(myColumn) = (myPerturbedTargetsCalculated - myUnperturbedTargetsCalculated) * pow(probeDistance, -1.0);
+	}
+
+	myPerturbedGuess[myColumn] = oldGuessValue;
+}
+
+template <class Model>
+void calculateJacobian(arma::Mat<double>& myJacobian, 
 		       arma::Col<double>& myTargetsCalculated, 
 		       arma::Col<double>& myCurrentGuess, 
-		       void myCalculateDependentVariables(const arma::Mat<double>&, const arma::Col<double>&, arma::Col<double>&))
+		       double myFunctionNoise,
+		       const Model& myCalculateDependentVariables)
 {
 	//Calculate a temporary, unperturbed target evaluation, such as is needed for the finite-difference
 	//formula
 	arma::Col<double> unperturbedTargetsCalculated(NUMDIMENSIONS);
 	unperturbedTargetsCalculated.fill(0.0);
-	myCalculateDependentVariables(myOffsets, myCurrentGuess, unperturbedTargetsCalculated);
-	double oldGuessValue = 0.0;
+	myCalculateDependentVariables(myCurrentGuess, unperturbedTargetsCalculated);
+	//Only needed by the schemes with two perturbed evaluations per column
+	arma::Col<double> secondPerturbedTargetsCalculated(NUMDIMENSIONS);
 
 	//Each iteration fills a column in the Jacobian
 	//The Jacobian takes this form:
@@ -208,42 +761,285 @@ void calculateJacobian(const arma::Mat<double>& myOffsets,
 	//
 	for(int j = 0; j< NUMDIMENSIONS; j++)
 	{
-		//Store old element value, perturb the current value
-		oldGuessValue = myCurrentGuess[j];
-		myCurrentGuess[j] += PROBEDISTANCE;
-
-		//Evaluate functions for perturbed guess
-		myCalculateDependentVariables(myOffsets, myCurrentGuess, myTargetsCalculated);
-
-		//The column of the Jacobian that goes with the independent variable we perturbed
+		//The column of the Jacobian that goes with the independent variable we perturb
 		//can be determined using the finite-difference formula
-		//The arma::Col allows this to be expressed as a single vector operation
-		//note slice works as: std::slice(start_index, number_of_elements_to_access, index_interval_between_selections)
-		//std::cout << "Jacobian column " << j << " with:" << std::endl;
-		//std::cout << "myTargetsCalculated" << std::endl;
-		//std::cout << myTargetsCalculated << std::endl;
-		//std::cout << "unperturbedTargetsCalculated" << std::endl;
-		//std::cout << unperturbedTargetsCalculated << std::endl;
-		myJacobian.col(j) = (myTargetsCalculated - unperturbedTargetsCalculated) * pow(PROBEDISTANCE, -1.0);
-		//std::cout << "The jacobian: " << std::endl;
-		//std::cout << myJacobian << std::endl;
-
-		myCurrentGuess[j] = oldGuessValue;
+		//myCurrentGuess is perturbed in place and restored, myTargetsCalculated is scratch space
+		calculateJacobianColumn(j,
+					myJacobian,
+					unperturbedTargetsCalculated,
+					myCurrentGuess,
+					myTargetsCalculated,
+					secondPerturbedTargetsCalculated,
+					myFunctionNoise,
+					myCalculateDependentVariables);
 	}
 
 	//Reset to unperturbed, so we dont waste a function evaluation
 	myTargetsCalculated = unperturbedTargetsCalculated;
 }
 
+template <class Model>
+void calculateParallelJacobian(arma::Mat<double>& myJacobian,
+			       arma::Col<double>& myTargetsCalculated,
+			       const arma::Col<double>& myCurrentGuess,
+			       ThreadPool& myThreadPool,
+			       double myFunctionNoise,
+			       const Model& myCalculateDependentVariables)
+{
+	//The unperturbed evaluation is shared read-only by all workers
+	myCalculateDependentVariables(myCurrentGuess, myTargetsCalculated);
+	const arma::Col<double>& unperturbedTargetsCalculated = myTargetsCalculated;
+
+	//One perturbed copy of the guess and one output buffer per worker,
+	//so the shared myCurrentGuess is never modified
+	std::vector<arma::Col<double> > perturbedGuesses(myThreadPool.size(), myCurrentGuess);
+	std::vector<arma::Col<double> > perturbedTargetsCalculated(myThreadPool.size(), arma::Col<double>(NUMDIMENSIONS));
+	std::vector<arma::Col<double> > secondPerturbedTargetsCalculated(myThreadPool.size(), arma::Col<double>(NUMDIMENSIONS));
+
+	//Each task fills a column in the Jacobian, workers never write to the same column
+	myThreadPool.parallelFor(NUMDIMENSIONS, [&](int j, int worker)
+	{
+		calculateJacobianColumn(j,
+					myJacobian,
+					unperturbedTargetsCalculated,
+					perturbedGuesses[worker],
+					perturbedTargetsCalculated[worker],
+					secondPerturbedTargetsCalculated[worker],
+					myFunctionNoise,
+					myCalculateDependentVariables);
+	});
+}
+
 void updateGuess(arma::Col<double>& myCurrentGuess,
 		 const arma::Col<double>& myTargetsCalculated,
 		 const arma::Mat<double>& myJacobian)
 {
-	//v = J(inverse) * (-F(x))
-	//new guess = v + old guess
+	//v = J(inverse) * F(x), from the fixed-size solver when NUMDIMENSIONS is small or by mixed precision
+	//new guess = old guess - v
 	std::cout << "Current Jacobian: " << std::endl;
 	std::cout << myJacobian << std::endl;
-	myCurrentGuess = myCurrentGuess + solve(myJacobian, -myTargetsCalculated, true);
+	arma::Col<double> guessChange(NUMDIMENSIONS);
+	bool solved = true;
+	if(USEMIXEDPRECISION)
+	{
+		int refinements = solveMixedPrecision(myJacobian, myTargetsCalculated, guessChange, REFINEMENTTOLERANCE, MAXREFINEMENTS);
+		std::cout << "Iterative refinement steps: " << refinements << std::endl;
+		solved = refinements >= 0;
+	}
+	else
+	{
+		solved = LinearSolver<NUMDIMENSIONS>::solve(myJacobian, myTargetsCalculated, guessChange);
+	}
+	if(not solved)
+	{
+		std::cout << "Singular Jacobian, the guess is not updated" << std::endl;
+		return;
+	}
+	myCurrentGuess = myCurrentGuess - guessChange;
+}
+
+void updateGuessModifiedNewton(arma::Col<double>& myCurrentGuess,
+			       const arma::Col<double>& myTargetsCalculated,
+			       const LUFactorization& myFactorization,
+			       const FactorizationReusePolicy& myReusePolicy)
+{
+	//v = J(inverse) * (-F(x)) with J the last factored Jacobian
+	//new guess = v + old guess
+	if(not myFactorization.isFactored())
+	{
+		std::cout << "Singular Jacobian, the guess is not updated" << std::endl;
+		return;
+	}
+	std::cout << "Steps since the last factorization: " << myReusePolicy.stepsSinceRefresh() << std::endl;
+	myCurrentGuess = myCurrentGuess + myFactorization.solve(-myTargetsCalculated);
+}
+
+void updateGuessTrustRegion(arma::Col<double>& myCurrentGuess,
+			    const arma::Col<double>& myTargetsDesired,
+			    const arma::Col<double>& myTargetsCalculated,
+			    const arma::Mat<double>& myJacobian,
+			    DoglegTrustRegion& myTrustRegion)
+{
+	//new guess = old guess + p, with p the dogleg step for J * p = -(F(x) - Ftarget) within the trust radius
+	std::cout << "Trust radius: " << myTrustRegion.radius() << std::endl;
+	myCurrentGuess = myCurrentGuess + myTrustRegion.step(myJacobian, myTargetsCalculated - myTargetsDesired);
+}
+
+void updateGuessBroyden(arma::Col<double>& myCurrentGuess,
+			const arma::Col<double>& myTargetsCalculated,
+			BroydenUpdate& myBroydenUpdate)
+{
+	//new guess = old guess - inverse(B) * F(x), where B is the last Jacobian with the Broyden updates applied
+	if(not myBroydenUpdate.isFactored())
+	{
+		std::cout << "Singular Jacobian, the guess is not updated" << std::endl;
+		return;
+	}
+	std::cout << "Broyden updates since the last Jacobian: " << myBroydenUpdate.numUpdates() << std::endl;
+	myCurrentGuess = myCurrentGuess + myBroydenUpdate.step(myTargetsCalculated);
+}
+
+template <class Model>
+int updateGuessJacobianFree(arma::Col<double>& myCurrentGuess,
+			    const arma::Col<double>& myTargetsCalculated,
+			    EisenstatWalkerForcingTerm& myForcingTerm,
+			    const Model& myCalculateDependentVariables)
+{
+	//myTargetsCalculated is F(x) from the end of the last iteration,
+	//the right hand side and the base point of every probe
+	arma::Col<double> perturbedGuess(NUMDIMENSIONS);
+	arma::Col<double> perturbedTargetsCalculated(NUMDIMENSIONS);
+
+	//Jacobian * v from one forward-difference probe along v
+	//The probe is scaled by the length of v so the guess always moves by KRYLOVPROBEDISTANCE
+	auto jacobianVectorProduct = [&](const arma::Col<double>& myDirection, arma::Col<double>& myProduct)
+	{
+		double directionNorm = arma::norm(myDirection, 2);
+		if(directionNorm == 0.0)
+		{
+			myProduct.zeros(NUMDIMENSIONS);
+			return;
+		}
+		double probeDistance = KRYLOVPROBEDISTANCE/directionNorm;
+		perturbedGuess = myCurrentGuess + probeDistance*myDirection;
+		myCalculateDependentVariables(perturbedGuess, perturbedTargetsCalculated);
+		myProduct = (perturbedTargetsCalculated - myTargetsCalculated) * pow(probeDistance, -1.0);
+	};
+
+	//J * v = -F(x), solved for v = new guess - old guess
+	//Inexact Newton only solves as tightly as the drop in ||F(x)|| calls for
+	double linearTolerance = KRYLOVTOLERANCE;
+	if(USEINEXACTNEWTON)
+	{
+		linearTolerance = myForcingTerm.next(arma::norm(myTargetsCalculated, 2), ERRORTOLLERANCE);
+	}
+	arma::Col<double> guessChange(NUMDIMENSIONS);
+	guessChange.fill(0.0);
+	double relativeLinearResidual = 0.0;
+	int krylovIterations = solveGMRES(jacobianVectorProduct,
+					  -myTargetsCalculated,
+					  guessChange,
+					  linearTolerance,
+					  MAXKRYLOVITERATIONS,
+					  KRYLOVRESTART,
+					  relativeLinearResidual);
+	std::cout << "GMRES iterations: " << krylovIterations << ", linear tolerance: " << linearTolerance
+		  << ", relative linear residual: " << relativeLinearResidual << std::endl;
+
+	myCurrentGuess = myCurrentGuess + guessChange;
+	return krylovIterations;
+}
+
+template <class Model>
+void solveTargetSweep(const arma::Mat<double>& mySweepTargets,
+		      arma::Mat<double>& mySweepGuesses,
+		      double myFunctionNoise,
+		      const Model& myCalculateDependentVariables)
+{
+	//Column k of mySweepGuesses is solved for column k of mySweepTargets
+	//Targets whose guesses are close share one Jacobian, taken at the guess of the first of them (the seed):
+	//J * V = [F(x_1) - t_1, ..., F(x_m) - t_m],  x_k = x_k - V.col(k)
+	const int numTargets = mySweepTargets.n_cols;
+	arma::Mat<double> jacobian(NUMDIMENSIONS, NUMDIMENSIONS);
+	arma::Mat<double> residuals(NUMDIMENSIONS, numTargets);
+	arma::Col<double> errors(numTargets);
+	std::vector<bool> converged(numTargets, false);
+	std::vector<bool> grouped(numTargets);
+	std::vector<int> group;
+	arma::Col<double> guess(NUMDIMENSIONS);
+	arma::Col<double> targetsCalculated(NUMDIMENSIONS);
+	arma::Col<double> perturbedTargetsCalculated(NUMDIMENSIONS);
+	arma::Col<double> secondPerturbedTargetsCalculated(NUMDIMENSIONS);
+	LUFactorization factorization;
+
+	//F(x) of every target that has not converged yet, nothing is re-evaluated for the converged ones
+	int count = 0;
+	int jacobians = 0;
+	while(true)
+	{
+		int numActive = 0;
+		for(int k = 0; k < numTargets; k++)
+		{
+			if(converged[k])
+			{
+				continue;
+			}
+			guess = mySweepGuesses.col(k);
+			myCalculateDependentVariables(guess, targetsCalculated);
+			residuals.col(k) = targetsCalculated - mySweepTargets.col(k);
+			errors[k] = arma::norm(residuals.col(k), 2);
+			converged[k] = errors[k] <= ERRORTOLLERANCE;
+			numActive += converged[k] ? 0 : 1;
+		}
+		std::cout << "Sweep targets not converged: " << numActive << std::endl;
+		if(count >= MAXITERATIONS or numActive == 0)
+		{
+			break;
+		}
+
+		//One Newton step per group of targets; a target far from every seed gets a Jacobian of its own
+		for(int k = 0; k < numTargets; k++)
+		{
+			grouped[k] = converged[k];
+		}
+		for(int seed = 0; seed < numTargets; seed++)
+		{
+			if(grouped[seed])
+			{
+				continue;
+			}
+			group.clear();
+			double radius = SWEEPGROUPRADIUS*(1.0 + arma::norm(mySweepGuesses.col(seed), 2));
+			for(int k = seed; k < numTargets; k++)
+			{
+				if(not grouped[k] and arma::norm(mySweepGuesses.col(k) - mySweepGuesses.col(seed), 2) <= radius)
+				{
+					grouped[k] = true;
+					group.push_back(k);
+				}
+			}
+
+			//F at the seed is its residual plus its target, the columns only need the perturbed evaluations
+			guess = mySweepGuesses.col(seed);
+			targetsCalculated = residuals.col(seed) + mySweepTargets.col(seed);
+			for(int j = 0; j < NUMDIMENSIONS; j++)
+			{
+				calculateJacobianColumn(j,
+							jacobian,
+							targetsCalculated,
+							guess,
+							perturbedTargetsCalculated,
+							secondPerturbedTargetsCalculated,
+							myFunctionNoise,
+							myCalculateDependentVariables);
+			}
+			jacobians++;
+			if(not factorization.factor(jacobian))
+			{
+				std::cout << "Singular Jacobian at the guess of sweep target " << seed << ", its group is not updated" << std::endl;
+				continue;
+			}
+
+			arma::Mat<double> groupResiduals(NUMDIMENSIONS, group.size());
+			for(size_t g = 0; g < group.size(); g++)
+			{
+				groupResiduals.col(g) = residuals.col(group[g]);
+			}
+			arma::Mat<double> steps = factorization.solveMultiple(groupResiduals);
+			for(size_t g = 0; g < group.size(); g++)
+			{
+				mySweepGuesses.col(group[g]) -= steps.col(g);
+			}
+		}
+		count++;
+	}
+
+	std::cout << "Sweep iterations: " << count << ", Jacobians: " << jacobians << std::endl;
+	for(int k = 0; k < numTargets; k++)
+	{
+		std::cout << "Sweep target " << k << ": residual error " << errors[k]
+			  << (converged[k] ? ", converged" : ", NOT converged") << std::endl;
+	}
 }
 
 void calculateResidual(const arma::Col<double>& myTargetsDesired, 
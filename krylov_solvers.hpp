@@ -0,0 +1,247 @@
+/*
+####Title:
+Krylov Linear Solvers for the Newton Raphson Examples
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+"solveGMRES" solves A*x = b with restarted GMRES without ever forming A. It only asks for products A*v through
+myMatrixVectorProduct(v, Av), so A can be a Jacobian that is never assembled: in a Jacobian-free Newton-Krylov
+(JFNK) solve, J*v is one directional derivative of the model, from a single finite-difference probe,
+complex-step probe or AD evaluation.
+
+GMRES builds an orthonormal (Krylov) basis v0, v1, ... from repeated products with A and picks the x in that basis
+with the smallest residual ||b - A*x||. The basis is kept in a NUMDIMENSIONS x (myRestart+1) matrix, so memory
+grows with NUMDIMENSIONS times the Krylov subspace size rather than NUMDIMENSIONS^2. After myRestart products
+the basis is thrown away and GMRES restarts from the current x.
+
+The return value is the number of GMRES iterations, i.e. Krylov basis vectors built. Each one costs a product with A,
+plus one more product per restart to recompute the true residual. On return mySolution holds the approximate
+solution (mySolution is also the initial guess) and myRelativeResidual holds ||b - A*x|| / ||b||.
+
+"solveBiCGStab" solves the same system with BiCGStab, which needs two products with A per iteration but only a fixed
+handful of vectors instead of a basis that grows until the restart. Its return value counts iterations the same way.
+
+Both take an optional right preconditioner, myPreconditioner(r, z) setting z ~= inverse(M)*r for some M close to A
+(preconditioners.hpp). They then solve A*inverse(M)*y = b and return x = inverse(M)*y, so the residual they check is
+still the true residual of A*x = b, while the number of iterations depends on how close A*inverse(M) is to I.
+*/
+
+#ifndef KRYLOV_SOLVERS_HPP
+#define KRYLOV_SOLVERS_HPP
+
+#include <cmath>
+#include <armadillo>
+
+//No preconditioning, z = r
+struct IdentityPreconditioner
+{
+	void operator()(const arma::Col<double>& residual, arma::Col<double>& preconditioned) const
+	{
+		preconditioned = residual;
+	}
+};
+
+template <typename MatrixVectorProduct, typename Preconditioner>
+int solveGMRES(MatrixVectorProduct& myMatrixVectorProduct,
+	       Preconditioner& myPreconditioner,
+	       const arma::Col<double>& myRightHandSide,
+	       arma::Col<double>& mySolution,
+	       double myRelativeTolerance,
+	       int myMaxIterations,
+	       int myRestart,
+	       double& myRelativeResidual)
+{
+	const arma::uword n = myRightHandSide.n_elem;
+	double rightHandSideNorm = arma::norm(myRightHandSide, 2);
+	if(rightHandSideNorm == 0.0)
+	{
+		mySolution.zeros(n);
+		myRelativeResidual = 0.0;
+		return 0;
+	}
+
+	arma::Mat<double> basis(n, myRestart + 1);
+	arma::Mat<double> hessenberg(myRestart + 1, myRestart);
+	arma::Col<double> givensCosines(myRestart);
+	arma::Col<double> givensSines(myRestart);
+	arma::Col<double> residualInBasis(myRestart + 1);
+	arma::Col<double> product(n);
+	arma::Col<double> residual(n);
+	arma::Col<double> preconditioned(n);
+
+	int iterations = 0;
+	myMatrixVectorProduct(mySolution, product);
+	residual = myRightHandSide - product;
+	double residualNorm = arma::norm(residual, 2);
+	myRelativeResidual = residualNorm/rightHandSideNorm;
+
+	while(myRelativeResidual > myRelativeTolerance and iterations < myMaxIterations)
+	{
+		basis.col(0) = residual/residualNorm;
+		hessenberg.fill(0.0);
+		residualInBasis.fill(0.0);
+		residualInBasis[0] = residualNorm;
+
+		int k = 0;
+		for(; k < myRestart and iterations < myMaxIterations; k++)
+		{
+			myPreconditioner(basis.col(k), preconditioned);
+			myMatrixVectorProduct(preconditioned, product);
+			iterations++;
+
+			//Modified Gram-Schmidt against the basis built so far (Arnoldi)
+			for(int i = 0; i <= k; i++)
+			{
+				hessenberg(i, k) = arma::dot(product, basis.col(i));
+				product -= hessenberg(i, k)*basis.col(i);
+			}
+			hessenberg(k + 1, k) = arma::norm(product, 2);
+
+			//Apply the previous Givens rotations to the new column, then zero its subdiagonal entry
+			for(int i = 0; i < k; i++)
+			{
+				double temp = givensCosines[i]*hessenberg(i, k) + givensSines[i]*hessenberg(i + 1, k);
+				hessenberg(i + 1, k) = -givensSines[i]*hessenberg(i, k) + givensCosines[i]*hessenberg(i + 1, k);
+				hessenberg(i, k) = temp;
+			}
+			double radius = std::sqrt(hessenberg(k, k)*hessenberg(k, k) + hessenberg(k + 1, k)*hessenberg(k + 1, k));
+			givensCosines[k] = hessenberg(k, k)/radius;
+			givensSines[k] = hessenberg(k + 1, k)/radius;
+			hessenberg(k, k) = radius;
+			residualInBasis[k + 1] = -givensSines[k]*residualInBasis[k];
+			residualInBasis[k] = givensCosines[k]*residualInBasis[k];
+
+			//The rotated right hand side gives the residual norm without forming x
+			myRelativeResidual = std::fabs(residualInBasis[k + 1])/rightHandSideNorm;
+			if(myRelativeResidual <= myRelativeTolerance or hessenberg(k + 1, k) == 0.0)
+			{
+				k++;
+				break;
+			}
+			basis.col(k + 1) = product/arma::norm(product, 2);
+		}
+
+		//Back substitution on the triangular system, then add the basis combination to the solution
+		arma::Col<double> coefficients(k);
+		for(int i = k - 1; i >= 0; i--)
+		{
+			coefficients[i] = residualInBasis[i];
+			for(int j = i + 1; j < k; j++)
+			{
+				coefficients[i] -= hessenberg(i, j)*coefficients[j];
+			}
+			coefficients[i] /= hessenberg(i, i);
+		}
+		//The basis spans the preconditioned space, so the combination goes through the preconditioner once
+		arma::Col<double> combination(n);
+		combination.fill(0.0);
+		for(int i = 0; i < k; i++)
+		{
+			combination += coefficients[i]*basis.col(i);
+		}
+		myPreconditioner(combination, preconditioned);
+		mySolution += preconditioned;
+
+		//Restart from the true residual
+		myMatrixVectorProduct(mySolution, product);
+		residual = myRightHandSide - product;
+		residualNorm = arma::norm(residual, 2);
+		myRelativeResidual = residualNorm/rightHandSideNorm;
+	}
+
+	return iterations;
+}
+
+template <typename MatrixVectorProduct>
+int solveGMRES(MatrixVectorProduct& myMatrixVectorProduct,
+	       const arma::Col<double>& myRightHandSide,
+	       arma::Col<double>& mySolution,
+	       double myRelativeTolerance,
+	       int myMaxIterations,
+	       int myRestart,
+	       double& myRelativeResidual)
+{
+	IdentityPreconditioner identity;
+	return solveGMRES(myMatrixVectorProduct, identity, myRightHandSide, mySolution,
+			  myRelativeTolerance, myMaxIterations, myRestart, myRelativeResidual);
+}
+
+template <typename MatrixVectorProduct, typename Preconditioner>
+int solveBiCGStab(MatrixVectorProduct& myMatrixVectorProduct,
+		  Preconditioner& myPreconditioner,
+		  const arma::Col<double>& myRightHandSide,
+		  arma::Col<double>& mySolution,
+		  double myRelativeTolerance,
+		  int myMaxIterations,
+		  double& myRelativeResidual)
+{
+	const arma::uword n = myRightHandSide.n_elem;
+	double rightHandSideNorm = arma::norm(myRightHandSide, 2);
+	if(rightHandSideNorm == 0.0)
+	{
+		mySolution.zeros(n);
+		myRelativeResidual = 0.0;
+		return 0;
+	}
+
+	arma::Col<double> residual(n);
+	arma::Col<double> product(n);
+	myMatrixVectorProduct(mySolution, product);
+	residual = myRightHandSide - product;
+	myRelativeResidual = arma::norm(residual, 2)/rightHandSideNorm;
+
+	//The shadow residual stays fixed, rho, alpha and omega are the usual BiCGStab scalars
+	arma::Col<double> shadowResidual = residual;
+	arma::Col<double> direction(n);
+	direction.fill(0.0);
+	arma::Col<double> directionProduct(n);
+	directionProduct.fill(0.0);
+	arma::Col<double> preconditionedDirection(n);
+	arma::Col<double> intermediate(n);
+	arma::Col<double> preconditionedIntermediate(n);
+	double rho = 1.0;
+	double alpha = 1.0;
+	double omega = 1.0;
+
+	int iterations = 0;
+	while(myRelativeResidual > myRelativeTolerance and iterations < myMaxIterations)
+	{
+		double newRho = arma::dot(shadowResidual, residual);
+		if(newRho == 0.0 or omega == 0.0)
+		{
+			//Breakdown, the caller sees the residual reached so far
+			break;
+		}
+		double beta = (newRho/rho)*(alpha/omega);
+		rho = newRho;
+		direction = residual + beta*(direction - omega*directionProduct);
+
+		myPreconditioner(direction, preconditionedDirection);
+		myMatrixVectorProduct(preconditionedDirection, directionProduct);
+		alpha = rho/arma::dot(shadowResidual, directionProduct);
+		intermediate = residual - alpha*directionProduct;
+		iterations++;
+
+		//Half step already good enough
+		if(arma::norm(intermediate, 2) <= myRelativeTolerance*rightHandSideNorm)
+		{
+			mySolution += alpha*preconditionedDirection;
+			residual = intermediate;
+			myRelativeResidual = arma::norm(residual, 2)/rightHandSideNorm;
+			break;
+		}
+
+		myPreconditioner(intermediate, preconditionedIntermediate);
+		myMatrixVectorProduct(preconditionedIntermediate, product);
+		omega = arma::dot(product, intermediate)/arma::dot(product, product);
+		mySolution += alpha*preconditionedDirection + omega*preconditionedIntermediate;
+		residual = intermediate - omega*product;
+		myRelativeResidual = arma::norm(residual, 2)/rightHandSideNorm;
+	}
+
+	return iterations;
+}
+
+#endif
@@ -0,0 +1,120 @@
+/*
+####Title:
+Backtracking Line Search for the Newton Raphson Examples
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+The full Newton step x + p is only guaranteed to reduce the residual close to the root; further away it can
+overshoot, which costs iterations or makes the iteration diverge. BacktrackingLineSearch shortens the step to
+x + lambda*p until the residual error (the L2 norm of targets - F, as in "calculateResidual") satisfies the
+Armijo sufficient decrease condition
+
+||targets - F(x + lambda*p)|| < (1 - sufficientDecrease*lambda) * ||targets - F(x)||
+
+The full step (lambda = 1) is evaluated by the main loop anyway, so "search" starts from that evaluation and
+only spends model evaluations when it fails. Every following lambda minimizes a parabola through the squared
+error at lambda = 0 and the last two trials (three-point parabolic interpolation), kept within [0.1, 0.5] of the
+last lambda so that a poor model of the error neither stalls nor barely shortens the step. The first backtrack
+only has two trials, so the parabola's slope at lambda = 0 is taken as that of the Newton direction,
+-2*||targets - F(x)||^2.
+
+If no lambda is accepted within maxBacktracks evaluations the last, shortest step is kept. A zero step, left by
+an iteration that skipped its update on a singular Jacobian, is returned at once without any evaluations.
+*/
+
+#ifndef LINE_SEARCH_HPP
+#define LINE_SEARCH_HPP
+
+#include <algorithm>
+#include <armadillo>
+
+class BacktrackingLineSearch
+{
+public:
+	BacktrackingLineSearch(double sufficientDecrease, int maxBacktracks)
+		: mySufficientDecrease(sufficientDecrease), myMaxBacktracks(maxBacktracks)
+	{
+	}
+
+	bool accepts(double stepLength, double previousError, double error) const
+	{
+		return error < (1.0 - mySufficientDecrease*stepLength)*previousError;
+	}
+
+	//On entry currentGuess, targetsCalculated and error belong to the full step from previousGuess,
+	//on return to the accepted step; returns the number of model evaluations spent on top of the full step
+	template <class Model, typename ElementType>
+	int search(const Model& model,
+		   const arma::Col<ElementType>& previousGuess,
+		   double previousError,
+		   const arma::Col<ElementType>& targetsDesired,
+		   arma::Col<ElementType>& currentGuess,
+		   arma::Col<ElementType>& targetsCalculated,
+		   double& error) const
+	{
+		const arma::Col<ElementType> step = currentGuess - previousGuess;
+		//A skipped step (singular Jacobian) leaves nothing to shorten
+		if(arma::norm(step, 2) == 0.0)
+		{
+			return 0;
+		}
+
+		double stepLength = 1.0;
+		double previousStepLength = 1.0;
+		double squaredError0 = previousError*previousError;
+		double squaredError = error*error;
+		double previousSquaredError = squaredError;
+
+		int evaluations = 0;
+		while(not accepts(stepLength, previousError, error) and evaluations < myMaxBacktracks)
+		{
+			double nextStepLength = 0.0;
+			if(evaluations == 0)
+			{
+				//Quadratic through the squared error at 0 and 1 with the slope of the Newton direction at 0
+				nextStepLength = squaredError0/(squaredError + squaredError0);
+			}
+			else
+			{
+				nextStepLength = parabolicMinimum(stepLength, previousStepLength, squaredError0, squaredError, previousSquaredError);
+			}
+			nextStepLength = std::min(std::max(nextStepLength, 0.1*stepLength), 0.5*stepLength);
+
+			previousStepLength = stepLength;
+			previousSquaredError = squaredError;
+			stepLength = nextStepLength;
+
+			currentGuess = previousGuess + stepLength*step;
+			model(currentGuess, targetsCalculated);
+			error = arma::norm(targetsDesired - targetsCalculated, 2);
+			squaredError = error*error;
+			evaluations++;
+		}
+		return evaluations;
+	}
+
+private:
+	//Minimum of the parabola through (0, squaredError0), (stepLength, squaredError) and
+	//(previousStepLength, previousSquaredError), or half the step if the parabola has no minimum
+	static double parabolicMinimum(double stepLength,
+				       double previousStepLength,
+				       double squaredError0,
+				       double squaredError,
+				       double previousSquaredError)
+	{
+		double curvature = previousStepLength*(squaredError - squaredError0) - stepLength*(previousSquaredError - squaredError0);
+		if(curvature >= 0.0)
+		{
+			return 0.5*stepLength;
+		}
+		double slope = stepLength*stepLength*(previousSquaredError - squaredError0) - previousStepLength*previousStepLength*(squaredError - squaredError0);
+		return -0.5*slope/curvature;
+	}
+
+	double mySufficientDecrease;
+	int myMaxBacktracks;
+};
+
+#endif
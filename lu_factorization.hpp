@@ -0,0 +1,132 @@
+/*
+####Title:
+Reusable LU Factorization for the Newton Raphson Examples
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+"solve(myJacobian, ...)" factors the Jacobian from scratch on every call, an O(NUMDIMENSIONS^3) operation.
+LUFactorization keeps the factors P*J = L*U of a Jacobian so that any number of right hand sides can be solved
+afterwards with two O(NUMDIMENSIONS^2) triangular solves:
+
+J*x = b  ->  L*y = P*b,  U*x = y
+
+"solveMultiple" takes a whole block of right hand sides, one per column, and does both triangular solves for all of
+them in one matrix-matrix call, which streams through the factors once instead of once per right hand side.
+
+FactorizationReusePolicy decides when the stored factors are too old to keep using (modified Newton). Newton
+with an outdated Jacobian still converges, only more slowly, so the factors are kept until either
+1)maxSteps steps have been taken with them, or
+2)a step reduced the residual by less than maxResidualRatio (new error > maxResidualRatio * previous error)
+and then the main loop computes and factors a fresh Jacobian.
+*/
+
+#ifndef LU_FACTORIZATION_HPP
+#define LU_FACTORIZATION_HPP
+
+#include <armadillo>
+
+class LUFactorization
+{
+public:
+	LUFactorization()
+		: myIsFactored(false)
+	{
+	}
+
+	bool isFactored() const
+	{
+		return myIsFactored;
+	}
+
+	//False if the matrix is singular, a zero pivot would be divided by in "solve"; "isFactored" is then false too
+	bool factor(const arma::Mat<double>& matrix)
+	{
+		myIsFactored = false;
+		arma::lu(myLower, myUpper, myPermutation, matrix);
+		for(arma::uword i = 0; i < myUpper.n_rows; i++)
+		{
+			if(myUpper(i, i) == 0.0)
+			{
+				return false;
+			}
+		}
+		myIsFactored = true;
+		return true;
+	}
+
+	//Forget the factors, e.g. when they are known to be stale
+	void clear()
+	{
+		myIsFactored = false;
+	}
+
+	//inverse(matrix) * rightHandSide from the stored factors
+	arma::Col<double> solve(const arma::Col<double>& rightHandSide) const
+	{
+		return arma::solve(arma::trimatu(myUpper), arma::solve(arma::trimatl(myLower), myPermutation*rightHandSide));
+	}
+
+	//inverse(matrix) * rightHandSides, every column of rightHandSides is solved at once
+	arma::Mat<double> solveMultiple(const arma::Mat<double>& rightHandSides) const
+	{
+		return arma::solve(arma::trimatu(myUpper), arma::solve(arma::trimatl(myLower), myPermutation*rightHandSides));
+	}
+
+private:
+	bool myIsFactored;
+	arma::Mat<double> myLower;
+	arma::Mat<double> myUpper;
+	arma::Mat<double> myPermutation;
+};
+
+class FactorizationReusePolicy
+{
+public:
+	FactorizationReusePolicy(int maxSteps, double maxResidualRatio)
+		: myMaxSteps(maxSteps), myMaxResidualRatio(maxResidualRatio), myStepsSinceRefresh(0), myNeedsRefresh(true)
+	{
+	}
+
+	bool needsRefresh() const
+	{
+		return myNeedsRefresh or myStepsSinceRefresh >= myMaxSteps;
+	}
+
+	int stepsSinceRefresh() const
+	{
+		return myStepsSinceRefresh;
+	}
+
+	//Call after a fresh Jacobian has been factored
+	void refreshed()
+	{
+		myStepsSinceRefresh = 0;
+		myNeedsRefresh = false;
+	}
+
+	//Call when the stored factors failed outright, e.g. a Krylov solve preconditioned with them did not converge
+	void invalidate()
+	{
+		myNeedsRefresh = true;
+	}
+
+	//Call after every step with the residual errors before and after it
+	void recordStep(double previousError, double error)
+	{
+		myStepsSinceRefresh++;
+		if(error > myMaxResidualRatio*previousError)
+		{
+			myNeedsRefresh = true;
+		}
+	}
+
+private:
+	int myMaxSteps;
+	double myMaxResidualRatio;
+	int myStepsSinceRefresh;
+	bool myNeedsRefresh;
+};
+
+#endif
@@ -0,0 +1,74 @@
+/*
+####Title:
+Mixed-Precision Linear Solver for the Newton Raphson Examples
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+"solveMixedPrecision" solves A*x = b to double precision while doing the O(NUMDIMENSIONS^3) LU factorization in
+single precision: the factors take half the memory and memory traffic, and twice as many floats as doubles fit
+in a SIMD register. The float solution alone is only good to about 1.0E-7 relative, so it is polished by
+iterative refinement, where everything but the correction solve is done in double precision:
+
+1)r = b - A*x (double)
+2)solve A*d = r with the float factors
+3)x = x + d (double)
+4)repeat until ||r|| <= myRelativeTolerance * ||b||, or myMaxRefinements corrections have been made
+
+Each correction costs O(NUMDIMENSIONS^2), and for a Jacobian that is not too badly conditioned
+(condition number well below 1.0E7) every one gains about seven digits, so one or two are usually enough.
+
+The return value is the number of corrections, or -1 if the single-precision factorization is singular.
+*/
+
+#ifndef MIXED_PRECISION_SOLVER_HPP
+#define MIXED_PRECISION_SOLVER_HPP
+
+#include <armadillo>
+
+inline int solveMixedPrecision(const arma::Mat<double>& myMatrix,
+			       const arma::Col<double>& myRightHandSide,
+			       arma::Col<double>& mySolution,
+			       double myRelativeTolerance,
+			       int myMaxRefinements)
+{
+	//P*A = L*U in single precision
+	arma::Mat<float> lower;
+	arma::Mat<float> upper;
+	arma::Mat<float> permutation;
+	arma::lu(lower, upper, permutation, arma::conv_to<arma::Mat<float> >::from(myMatrix));
+	for(arma::uword i = 0; i < upper.n_rows; i++)
+	{
+		if(upper(i, i) == 0.0f)
+		{
+			return -1;
+		}
+	}
+
+	//First solution straight from the float factors
+	arma::Col<float> residual = arma::conv_to<arma::Col<float> >::from(myRightHandSide);
+	arma::Col<float> correction = arma::solve(arma::trimatu(upper), arma::solve(arma::trimatl(lower), permutation*residual));
+	mySolution = arma::conv_to<arma::Col<double> >::from(correction);
+
+	double rightHandSideNorm = arma::norm(myRightHandSide, 2);
+	int refinements = 0;
+	while(refinements < myMaxRefinements)
+	{
+		//The residual has to be formed in double precision, or refinement cannot get past float accuracy
+		arma::Col<double> doubleResidual = myRightHandSide - myMatrix*mySolution;
+		if(arma::norm(doubleResidual, 2) <= myRelativeTolerance*rightHandSideNorm)
+		{
+			break;
+		}
+
+		residual = arma::conv_to<arma::Col<float> >::from(doubleResidual);
+		correction = arma::solve(arma::trimatu(upper), arma::solve(arma::trimatl(lower), permutation*residual));
+		mySolution += arma::conv_to<arma::Col<double> >::from(correction);
+		refinements++;
+	}
+
+	return refinements;
+}
+
+#endif
@@ -0,0 +1,223 @@
+/*
+####Title:
+Parallel Multi-Start Root Search with Duplicate Removal and Early Cancellation
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+A system with several roots needs several starting points to find them all. "searchRoots" runs NewtonSolver
+(newton_solver.hpp) from every column of myStartingPoints, spread over the workers of a ThreadPool
+(thread_pool.hpp) with "parallelForWorkStealing", and collects the distinct roots in a RootSet.
+
+RootSet is a spatial hash: space is divided into cubic cells of edge cellSize, and each root is filed under the
+cell it lies in. A point can only be within cellSize of roots in its own cell or the 3^NUMDIMENSIONS - 1 cells
+around it, so a lookup checks those cells instead of every root found. Lookups and insertions lock a mutex,
+and "insert" checks for a duplicate and adds the root under the same lock, so two workers converging to
+the same new root at the same time still add it once.
+
+Most starts of a multi-start search end at a root that another start has already found. Once an iterate is
+within myCaptureRadius of a known root, Newton's method converges to that root in a few more iterations, so
+the start is cancelled right there through the monitor of NewtonSolver::solve rather than spending those
+iterations' model evaluations on a duplicate. A converged start whose root is within myDuplicateTolerance of a
+known root is counted as a duplicate. Both radii must not exceed the cell size of the RootSet; a capture radius
+that is too large can cancel a start heading for a distinct root close to a known one.
+*/
+
+#ifndef MULTI_START_HPP
+#define MULTI_START_HPP
+
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <armadillo>
+#include "newton_solver.hpp"
+#include "thread_pool.hpp"
+
+class RootSet
+{
+public:
+	explicit RootSet(double cellSize)
+		: myCellSize(cellSize)
+	{
+	}
+
+	//Index of a root within radius <= cellSize of point, -1 if there is none
+	int findNear(const arma::Col<double>& point, double radius) const
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		return findNearLocked(point, radius);
+	}
+
+	//Adds root unless a root within radius <= cellSize is already known; true if it was added
+	bool insert(const arma::Col<double>& root, double radius)
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		if(findNearLocked(root, radius) >= 0)
+		{
+			return false;
+		}
+		myCells[cellOf(root)].push_back(int(myRoots.size()));
+		myRoots.push_back(root);
+		return true;
+	}
+
+	int size() const
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		return int(myRoots.size());
+	}
+
+	arma::Col<double> root(int index) const
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		return myRoots[index];
+	}
+
+private:
+	typedef std::vector<long long> Cell;
+
+	struct CellHash
+	{
+		std::size_t operator()(const Cell& cell) const
+		{
+			std::size_t hash = 0;
+			for(std::size_t i = 0; i < cell.size(); i++)
+			{
+				hash ^= std::hash<long long>()(cell[i]) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			}
+			return hash;
+		}
+	};
+
+	Cell cellOf(const arma::Col<double>& point) const
+	{
+		Cell cell(point.n_elem);
+		for(arma::uword i = 0; i < point.n_elem; i++)
+		{
+			cell[i] = (long long)std::floor(point[i]/myCellSize);
+		}
+		return cell;
+	}
+
+	int findNearLocked(const arma::Col<double>& point, double radius) const
+	{
+		const Cell center = cellOf(point);
+		const std::size_t n = center.size();
+
+		//Every combination of -1, 0, +1 offsets, counted like an odometer
+		std::vector<int> offsets(n, -1);
+		Cell neighbour(n);
+		while(true)
+		{
+			for(std::size_t i = 0; i < n; i++)
+			{
+				neighbour[i] = center[i] + offsets[i];
+			}
+			std::unordered_map<Cell, std::vector<int>, CellHash>::const_iterator found = myCells.find(neighbour);
+			if(found != myCells.end())
+			{
+				for(std::size_t k = 0; k < found->second.size(); k++)
+				{
+					if(arma::norm(myRoots[found->second[k]] - point, 2) < radius)
+					{
+						return found->second[k];
+					}
+				}
+			}
+
+			std::size_t i = 0;
+			while(i < n and offsets[i] == 1)
+			{
+				offsets[i] = -1;
+				i++;
+			}
+			if(i == n)
+			{
+				return -1;
+			}
+			offsets[i]++;
+		}
+	}
+
+	double myCellSize;
+	mutable std::mutex myMutex;
+	std::vector<arma::Col<double> > myRoots;
+	std::unordered_map<Cell, std::vector<int>, CellHash> myCells;
+};
+
+struct MultiStartResult
+{
+	int numRoots;
+	int numDuplicates;
+	int numCancelled;
+	int numFailed;
+	long totalIterations;
+};
+
+template <class Model, class JacobianPolicy, class LinearSolverPolicy>
+MultiStartResult searchRoots(ThreadPool& myThreadPool,
+			     const Model& myModel,
+			     const arma::Mat<double>& myStartingPoints,
+			     const arma::Col<double>& myTargets,
+			     int myMaxIterations,
+			     double myErrorTolerance,
+			     double myDuplicateTolerance,
+			     double myCaptureRadius,
+			     const JacobianPolicy& myJacobianPolicy,
+			     const LinearSolverPolicy& myLinearSolver,
+			     RootSet& myRoots)
+{
+	std::atomic<int> numRoots(0);
+	std::atomic<int> numDuplicates(0);
+	std::atomic<int> numCancelled(0);
+	std::atomic<int> numFailed(0);
+	std::atomic<long> totalIterations(0);
+
+	myThreadPool.parallelForWorkStealing(int(myStartingPoints.n_cols), [&](int start, int)
+	{
+		NewtonSolver<Model, JacobianPolicy, LinearSolverPolicy> solver(myModel,
+									       myMaxIterations,
+									       myErrorTolerance,
+									       myJacobianPolicy,
+									       myLinearSolver);
+		auto notCaptured = [&](const arma::Col<double>& guess, double)
+		{
+			return myRoots.findNear(guess, myCaptureRadius) < 0;
+		};
+
+		arma::Col<double> guess = myStartingPoints.col(start);
+		NewtonResult result = solver.solve(guess, myTargets, notCaptured);
+		totalIterations += result.iterations;
+
+		if(result.cancelled)
+		{
+			numCancelled++;
+		}
+		else if(not result.converged)
+		{
+			numFailed++;
+		}
+		else if(myRoots.insert(guess, myDuplicateTolerance))
+		{
+			numRoots++;
+		}
+		else
+		{
+			numDuplicates++;
+		}
+	});
+
+	MultiStartResult result;
+	result.numRoots = numRoots;
+	result.numDuplicates = numDuplicates;
+	result.numCancelled = numCancelled;
+	result.numFailed = numFailed;
+	result.totalIterations = totalIterations;
+	return result;
+}
+
+#endif
@@ -0,0 +1,280 @@
+/*
+####Title:
+Example Newton Raphson Solver: Multi-Lane Complex Step with Dual Numbers
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+Program solves for the location of the sole intersection of three infinite paraboloids
+which exist as parabola shaped surfaces in 3D space according to the following equations:
+
+(x-1)^2 + y^2 + z = 0
+x^2 + y^2 -(z+1) = 0
+x^2 + y^2 +(z-1) = 0
+
+They should intersect at the point (1, 0, 0)
+
+The model "ParaboloidModel" is specific to this problem, however everything else is largely general.
+It is a function object that carries the offsets of the paraboloids and whose operator() is templated on the scalar
+type, so the same model object is evaluated with MultiDual<NUMLANES> for the Jacobian and with double at the
+updated guess, see automatic_differentiation.cpp.
+
+The method "calculateJacobian" in complex_step.cpp perturbs one independent variable per complex model evaluation.
+Here the independent variables are MultiDual<NUMLANES> numbers (multilane_dual.hpp), which carry NUMLANES
+separate dual parts. A dual part behaves like the imaginary part of complex step, except that the square of a
+perturbation is exactly zero, so no probe distance is needed. The method "calculateJacobian" demonstrates the
+multi-lane technique:
+1)Up to NUMLANES independent variables are seeded at once, each one with 1.0 in its own dual lane
+2)The model is evaluated once
+3)The dual part of lane k is the column of the Jacobian for the variable seeded in lane k
+4)The real part is the unperturbed model evaluation, so no separate unperturbed evaluation is needed
+5)Steps 1 to 3 are repeated until every column is filled
+
+A Jacobian then costs ceil(NUMDIMENSIONS/NUMLANES) model evaluations instead of NUMDIMENSIONS+1.
+Its columns are exact up to rounding, as with automatic differentiation, with no subtractive cancellation.
+
+The Jacobian matrix looks like this:
+dE1/dx | dE1/dy | dE1/dz
+------------------------
+dE2/dx | dE2/dy | dE2/dz
+------------------------
+dE3/dx | dE3/dy | dE3/dz
+
+The Newton Raphson scheme is the same one described in complex_step.cpp.
+
+####Dependencies:
+The "Armadillo" C++ API was chosen to handle the linear algebra tasks because of its clear syntax
+and integration with LAPACK. For a list of dependences and installation instructions for
+Armadillo refer to the Armadillo project page at sourceforge.net.
+
+As of 20 Aug. 2013, Armadillo can be obtained at: http://arma.sourceforge.net/
+*/
+
+#include <iostream>
+#include <vector>
+#include <armadillo>
+#include "multilane_dual.hpp"
+#include "small_linear_solver.hpp"
+
+const int NUMDIMENSIONS = 3;
+const int MAXITERATIONS = 9;
+const double ERRORTOLLERANCE = 1.0E-4;
+//Number of dual lanes, i.e. Jacobian columns filled per model evaluation
+const int NUMLANES = 4;
+
+typedef MultiDual<NUMLANES> MD;
+
+//The problem being solved is to find the intersection of three infinite paraboloids:
+//(x-1)^2 + y^2 + z = 0
+//x^2 + y^2 -(z+1) = 0
+//x^2 + y^2 +(z-1) = 0
+//
+//They should intersect at the point (1, 0, 0)
+class ParaboloidModel
+{
+public:
+	ParaboloidModel()
+	{
+		//Offsets of the paraboloids, one row per equation
+		for(int i = 0; i < NUMDIMENSIONS; i++)
+		{
+			for(int j = 0; j < NUMDIMENSIONS; j++)
+			{
+				myOffsets[i][j] = 0.0;
+			}
+		}
+		myOffsets[0][0] = 1.0;
+		myOffsets[1][2] = 1.0;
+		myOffsets[2][2] = 1.0;
+	}
+
+	template <typename Scalar>
+	void operator()(const std::vector<Scalar>& myCurrentGuess, std::vector<Scalar>& targetsCalculated) const;
+
+private:
+	double myOffsets[NUMDIMENSIONS][NUMDIMENSIONS];
+};
+
+template <class Model>
+void calculateJacobian(arma::Mat<double>& myJacobian,
+		       arma::Col<double>& myTargetsCalculated,
+		       const arma::Col<double>& myCurrentGuess,
+		       const Model& myCalculateDependentVariables);
+
+void updateGuess(arma::Col<double>& myCurrentGuess,
+		 const arma::Col<double>& myTargetsCalculated,
+		 const arma::Mat<double>& myJacobian);
+
+void calculateResidual(const arma::Col<double>& myTargetsDesired,
+		       const arma::Col<double>& myTargetsCalculated,
+		       double& myError);
+
+int main(int argc, char* argv[])
+{
+	//--This first declaration is included for software engineering reasons: allow main method to control flow of data
+	//The model is handed to calculateJacobian as a function object, so it carries its own offsets
+	//and the compiler can inline it for every scalar type it is evaluated with
+	ParaboloidModel yourCalculateDependentVariables;
+
+	//We need to initialize the target vectors and provide an initial guess
+	arma::Col<double> targetsDesired(NUMDIMENSIONS);
+	targetsDesired.fill(0.0);
+
+	arma::Col<double> targetsCalculated(NUMDIMENSIONS);
+	targetsCalculated.fill(0.0);
+
+	arma::Col<double> currentGuess(NUMDIMENSIONS);
+	currentGuess.fill(2.0);
+
+	//Only needed for the model evaluation at the updated guess, which needs no derivatives
+	std::vector<double> updatedGuess(NUMDIMENSIONS);
+	std::vector<double> updatedTargetsCalculated(NUMDIMENSIONS);
+
+	//Place to store our tangent-stiffness matrix or Jacobian
+	//One element for every combination of dependent variable with independent variable
+	arma::Mat<double> jacobian(NUMDIMENSIONS, NUMDIMENSIONS);
+	jacobian.fill(0.0);
+
+	int count = 0;
+	double error = 1.0E5;
+
+	std::cout << "Running multi-lane complex step example ................" << std::endl;
+	std::cout << "Model evaluations per Jacobian: " << (NUMDIMENSIONS + NUMLANES - 1)/NUMLANES
+		  << " (single lane: " << NUMDIMENSIONS + 1 << ")" << std::endl;
+	while(count < MAXITERATIONS and error > ERRORTOLLERANCE)
+	{
+
+		//Calculate Jacobian tangent to currentGuess point
+		//at the same time, an unperturbed targetsCalculated is, well, calculated
+		calculateJacobian(jacobian,
+				  targetsCalculated,
+				  currentGuess,
+				  yourCalculateDependentVariables);
+
+		//Compute a new currentGuess
+		updateGuess(currentGuess,
+			    targetsCalculated,
+			    jacobian);
+
+		//Compute F(x) with the updated, currentGuess, in plain doubles since no lane would be perturbed
+		for(int j = 0; j < NUMDIMENSIONS; j++)
+		{
+			updatedGuess[j] = currentGuess[j];
+		}
+		yourCalculateDependentVariables(updatedGuess,
+						updatedTargetsCalculated);
+		for(int i = 0; i < NUMDIMENSIONS; i++)
+		{
+			targetsCalculated[i] = updatedTargetsCalculated[i];
+		}
+
+		//Calculate the L2 norm of Ftarget - F(xCurrentGuess)
+		calculateResidual(targetsDesired,
+				  targetsCalculated,
+				  error);
+
+		count ++;
+		//If we have converged, or if we have exceeded our alloted number of iterations, discontinue the loop
+		std::cout << "Residual Error: " << error << std::endl;
+	}
+
+	std::cout << "******************************************" << std::endl;
+	std::cout << "Number of iterations: " << count << std::endl;
+	std::cout << "Final guess:\n x, y, z\n" << currentGuess.t();
+	std::cout << "Error tollerance: " << ERRORTOLLERANCE << std::endl;
+	std::cout << "Final error: " << error << std::endl;
+	std::cout << "--program complete--" << std::endl;
+
+	return 0;
+}
+
+
+//This function is specific to a single problem
+template <typename Scalar>
+void ParaboloidModel::operator()(const std::vector<Scalar>& myCurrentGuess, std::vector<Scalar>& targetsCalculated) const
+{
+	//Evaluate a dependent variable for each iteration
+	//Every arithmetic operation below acts on all lanes at once
+	for(int i = 0; i < NUMDIMENSIONS; i++)
+	{
+		targetsCalculated[i] = pow(myCurrentGuess[0] - myOffsets[i][0], 2.0) + pow(myCurrentGuess[1] - myOffsets[i][1], 2.0);
+		targetsCalculated[i] = targetsCalculated[i] + myCurrentGuess[2]*pow(-1.0, i) - myOffsets[i][2];
+	}
+}
+
+template <class Model>
+void calculateJacobian(arma::Mat<double>& myJacobian,
+		       arma::Col<double>& myTargetsCalculated,
+		       const arma::Col<double>& myCurrentGuess,
+		       const Model& myCalculateDependentVariables)
+{
+	std::vector<MD> perturbedGuess(NUMDIMENSIONS);
+	std::vector<MD> perturbedTargetsCalculated(NUMDIMENSIONS);
+
+	//Each iteration fills up to NUMLANES columns in the Jacobian
+	//The Jacobian takes this form:
+	//
+	//	dF0/dx0 dF0/dx1
+	//	dF1/dx0 dF1/dx1
+	//
+	for(int firstColumn = 0; firstColumn < NUMDIMENSIONS; firstColumn += NUMLANES)
+	{
+		//Start every pass from the unperturbed guess, then seed column firstColumn+k in lane k
+		for(int j = 0; j < NUMDIMENSIONS; j++)
+		{
+			perturbedGuess[j] = MD(myCurrentGuess[j]);
+		}
+		for(int k = 0; k < NUMLANES and firstColumn + k < NUMDIMENSIONS; k++)
+		{
+			perturbedGuess[firstColumn + k].dualParts[k] = 1.0;
+		}
+
+		//Evaluate functions for perturbed guess
+		myCalculateDependentVariables(perturbedGuess, perturbedTargetsCalculated);
+
+		//The real part is never perturbed, so the first pass also gives the unperturbed evaluation
+		if(firstColumn == 0)
+		{
+			for(int i = 0; i < NUMDIMENSIONS; i++)
+			{
+				myTargetsCalculated[i] = perturbedTargetsCalculated[i].realPart;
+			}
+		}
+
+		//Lane k holds the column of the Jacobian that goes with the independent variable perturbed in it
+		for(int k = 0; k < NUMLANES and firstColumn + k < NUMDIMENSIONS; k++)
+		{
+			for(int i = 0; i < NUMDIMENSIONS; i++)
+			{
+				myJacobian(i, firstColumn + k) = perturbedTargetsCalculated[i].dualParts[k];
+			}
+		}
+	}
+}
+
+void updateGuess(arma::Col<double>& myCurrentGuess,
+		 const arma::Col<double>& myTargetsCalculated,
+		 const arma::Mat<double>& myJacobian)
+{
+	//v = J(inverse) * F(x), from the fixed-size solver when NUMDIMENSIONS is small
+	//new guess = old guess - v
+	std::cout << "Current Jacobian: " << std::endl;
+	std::cout << myJacobian << std::endl;
+	arma::Col<double> guessChange(NUMDIMENSIONS);
+	if(not LinearSolver<NUMDIMENSIONS>::solve(myJacobian, myTargetsCalculated, guessChange))
+	{
+		std::cout << "Singular Jacobian, the guess is not updated" << std::endl;
+		return;
+	}
+	myCurrentGuess = myCurrentGuess - guessChange;
+}
+
+void calculateResidual(const arma::Col<double>& myTargetsDesired,
+		       const arma::Col<double>& myTargetsCalculated,
+		       double& myError)
+{
+	//error is the l2 norm of the difference from my state to my target
+	myError = arma::norm((myTargetsDesired - myTargetsCalculated), 2);
+}
+
@@ -0,0 +1,191 @@
+/*
+####Title:
+Multi-Lane Dual Number for the Multi-Lane Complex Step Example
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+MultiDual<K> is a real part with K independent dual parts ("lanes"):
+
+x = realPart + dualParts[0]*e0 + dualParts[1]*e1 + ... + dualParts[K-1]*e(K-1),   with ek*el = 0 for every k, l
+
+It is a dual number, not a complex one: the products of two perturbations are zero by definition rather than -h^2.
+Complex step (complex_step.cpp) keeps those terms and only gets away with ignoring them because h is tiny; a dual
+number drops them exactly, which is forward-mode automatic differentiation with K derivative slots.
+Each lane carries its own perturbation, so one model evaluation probes K directions at once. Seeding a lane with
+1.0 makes its dual part the exact first derivative in that direction, with no probe distance and no subtractive
+cancellation, and the real part is the unperturbed model value.
+
+The dual parts are stored contiguously and every operator loops over them with the compile-time
+trip count K, so the compiler can keep them in SIMD registers (K = 4 fills one AVX register of doubles).
+They are deliberately not over-aligned with alignas: the example keeps MultiDual in std::vector, whose
+allocator only honours over-alignment from C++17 on, and the compiler emits unaligned vector loads anyway.
+
+Only the operations needed by the example models are provided; each one follows the chain rule
+d(f(x)) = f'(realPart)*d(x) for every lane.
+
+Requires C++11 (compile with -std=c++11).
+*/
+
+#ifndef MULTILANE_DUAL_HPP
+#define MULTILANE_DUAL_HPP
+
+#include <cmath>
+
+template <int K>
+struct MultiDual
+{
+	double dualParts[K];
+	double realPart;
+
+	MultiDual(double myRealPart = 0.0)
+		: realPart(myRealPart)
+	{
+		for(int k = 0; k < K; k++)
+		{
+			dualParts[k] = 0.0;
+		}
+	}
+
+	MultiDual& operator+=(const MultiDual& other)
+	{
+		realPart += other.realPart;
+		for(int k = 0; k < K; k++)
+		{
+			dualParts[k] += other.dualParts[k];
+		}
+		return *this;
+	}
+
+	MultiDual& operator-=(const MultiDual& other)
+	{
+		realPart -= other.realPart;
+		for(int k = 0; k < K; k++)
+		{
+			dualParts[k] -= other.dualParts[k];
+		}
+		return *this;
+	}
+
+	MultiDual& operator*=(const MultiDual& other)
+	{
+		for(int k = 0; k < K; k++)
+		{
+			dualParts[k] = realPart*other.dualParts[k] + dualParts[k]*other.realPart;
+		}
+		realPart *= other.realPart;
+		return *this;
+	}
+
+	MultiDual& operator/=(const MultiDual& other)
+	{
+		double inverse = 1.0/other.realPart;
+		double quotient = realPart*inverse;
+		for(int k = 0; k < K; k++)
+		{
+			dualParts[k] = (dualParts[k] - quotient*other.dualParts[k])*inverse;
+		}
+		realPart = quotient;
+		return *this;
+	}
+};
+
+template <int K>
+MultiDual<K> operator+(MultiDual<K> a, const MultiDual<K>& b) { return a += b; }
+
+template <int K>
+MultiDual<K> operator-(MultiDual<K> a, const MultiDual<K>& b) { return a -= b; }
+
+template <int K>
+MultiDual<K> operator*(MultiDual<K> a, const MultiDual<K>& b) { return a *= b; }
+
+template <int K>
+MultiDual<K> operator/(MultiDual<K> a, const MultiDual<K>& b) { return a /= b; }
+
+template <int K>
+MultiDual<K> operator+(MultiDual<K> a, double b) { a.realPart += b; return a; }
+
+template <int K>
+MultiDual<K> operator+(double a, MultiDual<K> b) { b.realPart += a; return b; }
+
+template <int K>
+MultiDual<K> operator-(MultiDual<K> a, double b) { a.realPart -= b; return a; }
+
+template <int K>
+MultiDual<K> operator-(double a, const MultiDual<K>& b) { return MultiDual<K>(a) - b; }
+
+template <int K>
+MultiDual<K> operator-(const MultiDual<K>& a) { return MultiDual<K>(0.0) - a; }
+
+template <int K>
+MultiDual<K> operator*(MultiDual<K> a, double b)
+{
+	a.realPart *= b;
+	for(int k = 0; k < K; k++)
+	{
+		a.dualParts[k] *= b;
+	}
+	return a;
+}
+
+template <int K>
+MultiDual<K> operator*(double a, const MultiDual<K>& b) { return b*a; }
+
+template <int K>
+MultiDual<K> operator/(const MultiDual<K>& a, double b) { return a*(1.0/b); }
+
+template <int K>
+MultiDual<K> operator/(double a, const MultiDual<K>& b) { return MultiDual<K>(a) / b; }
+
+//f(x) with every lane scaled by f'(realPart)
+template <int K>
+MultiDual<K> chainRule(const MultiDual<K>& x, double value, double derivative)
+{
+	MultiDual<K> result(value);
+	for(int k = 0; k < K; k++)
+	{
+		result.dualParts[k] = derivative*x.dualParts[k];
+	}
+	return result;
+}
+
+template <int K>
+MultiDual<K> pow(const MultiDual<K>& x, double p)
+{
+	return chainRule(x, std::pow(x.realPart, p), p*std::pow(x.realPart, p - 1.0));
+}
+
+template <int K>
+MultiDual<K> sqrt(const MultiDual<K>& x)
+{
+	double root = std::sqrt(x.realPart);
+	return chainRule(x, root, 0.5/root);
+}
+
+template <int K>
+MultiDual<K> exp(const MultiDual<K>& x)
+{
+	double e = std::exp(x.realPart);
+	return chainRule(x, e, e);
+}
+
+template <int K>
+MultiDual<K> log(const MultiDual<K>& x)
+{
+	return chainRule(x, std::log(x.realPart), 1.0/x.realPart);
+}
+
+template <int K>
+MultiDual<K> sin(const MultiDual<K>& x)
+{
+	return chainRule(x, std::sin(x.realPart), std::cos(x.realPart));
+}
+
+template <int K>
+MultiDual<K> cos(const MultiDual<K>& x)
+{
+	return chainRule(x, std::cos(x.realPart), -std::sin(x.realPart));
+}
+
+#endif
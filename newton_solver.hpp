@@ -0,0 +1,313 @@
+/*
+####Title:
+Header-Only Templated Newton Raphson Solver
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+forward_difference.cpp, complex_step.cpp and automatic_differentiation.cpp repeat the same plain Newton Raphson
+loop and differ only in how the Jacobian is obtained. NewtonSolver<Model, JacobianPolicy, LinearSolverPolicy> is
+that loop written once, with the differences turned into template parameters. The three examples keep their own
+loops, which also carry their other modes; newton_solver_example.cpp and the headers built on top of NewtonSolver
+(batch_solver.hpp, multi_start.hpp, continuation.hpp, solution_cache.hpp) are its users:
+
+-Model: the system of equations, a function object templated on the scalar type it is evaluated with,
+ template <typename Scalar> void operator()(const std::valarray<Scalar>& x, std::valarray<Scalar>& F) const
+ std::valarray is used because it holds double, std::complex<double> and the Sacado AD types alike.
+-JacobianPolicy: computes the Jacobian at x, evaluating the Model with the scalar type it needs. It is also given
+ F(x), which "solve" already has from the end of the last iteration, so no policy evaluates the model at x itself
+ -ForwardDifferenceJacobian: double, NUMDIMENSIONS model evaluations, F(x) is the unperturbed base point
+ -ComplexStepJacobian: std::complex<double>, NUMDIMENSIONS model evaluations
+ -AutomaticDifferentiationJacobian<FadType>: a Sacado forward AD type, one model evaluation
+ An iteration costs the policy's evaluations plus the one of F at the updated guess.
+-LinearSolverPolicy: solves J*v = F(x) - targets for the Newton step v
+ -DenseLinearSolver: LAPACK through arma::solve, any size
+ -FixedSizeLinearSolver<N>: the unrolled solver of small_linear_solver.hpp for N unknowns known at compile time
+ -MixedPrecisionLinearSolver: single-precision LU with double-precision refinement (mixed_precision_solver.hpp)
+
+The policies are stored by value and called directly, never through a function pointer or a virtual function,
+so the compiler sees the whole iteration, model included, and can inline it. Nothing here depends on Sacado;
+AutomaticDifferentiationJacobian only uses the FadType it is instantiated with.
+
+"solve" optionally takes a monitor, called as monitor(guess, error) after every iteration; returning false cancels
+the solve (e.g. a multi-start search dropping a start that is about to find a known root, multi_start.hpp).
+*/
+
+#ifndef NEWTON_SOLVER_HPP
+#define NEWTON_SOLVER_HPP
+
+#include <complex>
+#include <valarray>
+#include <armadillo>
+#include "mixed_precision_solver.hpp"
+#include "small_linear_solver.hpp"
+
+struct NewtonResult
+{
+	int iterations;
+	double error;
+	bool converged;
+	bool cancelled;
+};
+
+class ForwardDifferenceJacobian
+{
+public:
+	explicit ForwardDifferenceJacobian(double probeDistance = 1.0E-10)
+		: myProbeDistance(probeDistance)
+	{
+	}
+
+	template <class Model>
+	void operator()(const Model& model, const arma::Col<double>& point, const arma::Col<double>& values, arma::Mat<double>& jacobian)
+	{
+		//values is F(point), the unperturbed evaluation every column is differenced against
+		const arma::uword n = point.n_elem;
+		myPoint.resize(n);
+		myPerturbedValues.resize(n);
+		for(arma::uword i = 0; i < n; i++)
+		{
+			myPoint[i] = point[i];
+		}
+
+		//One column per perturbed unknown
+		for(arma::uword j = 0; j < n; j++)
+		{
+			myPoint[j] += myProbeDistance;
+			model(myPoint, myPerturbedValues);
+			for(arma::uword i = 0; i < n; i++)
+			{
+				jacobian(i, j) = (myPerturbedValues[i] - values[i])/myProbeDistance;
+			}
+			myPoint[j] = point[j];
+		}
+	}
+
+private:
+	double myProbeDistance;
+	std::valarray<double> myPoint;
+	std::valarray<double> myPerturbedValues;
+};
+
+class ComplexStepJacobian
+{
+public:
+	explicit ComplexStepJacobian(double probeDistance = 1.0E-30)
+		: myProbeDistance(probeDistance)
+	{
+	}
+
+	template <class Model>
+	void operator()(const Model& model, const arma::Col<double>& point, const arma::Col<double>&, arma::Mat<double>& jacobian)
+	{
+		//dF/dx_j = imag(F(x + i*h*e_j))/h, without subtractive cancellation, so F(x) itself is not needed
+		const arma::uword n = point.n_elem;
+		myPoint.resize(n);
+		myValues.resize(n);
+		for(arma::uword i = 0; i < n; i++)
+		{
+			myPoint[i] = std::complex<double>(point[i], 0.0);
+		}
+
+		for(arma::uword j = 0; j < n; j++)
+		{
+			myPoint[j] = std::complex<double>(point[j], myProbeDistance);
+			model(myPoint, myValues);
+			for(arma::uword i = 0; i < n; i++)
+			{
+				jacobian(i, j) = myValues[i].imag()/myProbeDistance;
+			}
+			myPoint[j] = std::complex<double>(point[j], 0.0);
+		}
+	}
+
+private:
+	double myProbeDistance;
+	std::valarray<std::complex<double> > myPoint;
+	std::valarray<std::complex<double> > myValues;
+};
+
+template <typename FadType>
+class AutomaticDifferentiationJacobian
+{
+public:
+	template <class Model>
+	void operator()(const Model& model, const arma::Col<double>& point, const arma::Col<double>&, arma::Mat<double>& jacobian)
+	{
+		//Every unknown is an independent variable, one evaluation carries all partial derivatives
+		//Its values would be F(x) again, so only the derivatives are read
+		const arma::uword n = point.n_elem;
+		myPoint.resize(n);
+		myValues.resize(n);
+		for(arma::uword i = 0; i < n; i++)
+		{
+			myPoint[i] = FadType(int(n), int(i), point[i]);
+		}
+		model(myPoint, myValues);
+
+		for(arma::uword i = 0; i < n; i++)
+		{
+			for(arma::uword j = 0; j < n; j++)
+			{
+				jacobian(i, j) = myValues[i].dx(int(j));
+			}
+		}
+	}
+
+private:
+	std::valarray<FadType> myPoint;
+	std::valarray<FadType> myValues;
+};
+
+class DenseLinearSolver
+{
+public:
+	bool operator()(const arma::Mat<double>& jacobian, const arma::Col<double>& rightHandSide, arma::Col<double>& solution) const
+	{
+		return arma::solve(solution, jacobian, rightHandSide);
+	}
+};
+
+template <int N>
+class FixedSizeLinearSolver
+{
+public:
+	bool operator()(const arma::Mat<double>& jacobian, const arma::Col<double>& rightHandSide, arma::Col<double>& solution) const
+	{
+		return LinearSolver<N>::solve(jacobian, rightHandSide, solution);
+	}
+};
+
+class MixedPrecisionLinearSolver
+{
+public:
+	explicit MixedPrecisionLinearSolver(double relativeTolerance = 1.0E-14, int maxRefinements = 5)
+		: myRelativeTolerance(relativeTolerance), myMaxRefinements(maxRefinements)
+	{
+	}
+
+	bool operator()(const arma::Mat<double>& jacobian, const arma::Col<double>& rightHandSide, arma::Col<double>& solution) const
+	{
+		return solveMixedPrecision(jacobian, rightHandSide, solution, myRelativeTolerance, myMaxRefinements) >= 0;
+	}
+
+private:
+	double myRelativeTolerance;
+	int myMaxRefinements;
+};
+
+template <class Model, class JacobianPolicy, class LinearSolverPolicy = DenseLinearSolver>
+class NewtonSolver
+{
+public:
+	NewtonSolver(const Model& model,
+		     int maxIterations,
+		     double errorTolerance,
+		     const JacobianPolicy& jacobianPolicy = JacobianPolicy(),
+		     const LinearSolverPolicy& linearSolver = LinearSolverPolicy())
+		: myModel(model), myJacobianPolicy(jacobianPolicy), myLinearSolver(linearSolver),
+		  myMaxIterations(maxIterations), myErrorTolerance(errorTolerance)
+	{
+	}
+
+	//Iterates guess until F(guess) is within the error tolerance of targets, in the L2 norm
+	//A guess that is already within the tolerance is returned after 0 iterations
+	//A singular Jacobian ends the iteration early with converged false
+	NewtonResult solve(arma::Col<double>& guess, const arma::Col<double>& targets)
+	{
+		auto neverCancel = [](const arma::Col<double>&, double) { return true; };
+		return solve(guess, targets, neverCancel);
+	}
+
+	//The same, ending early with cancelled true as soon as monitor(guess, error) returns false
+	template <class Monitor>
+	NewtonResult solve(arma::Col<double>& guess, const arma::Col<double>& targets, const Monitor& monitor)
+	{
+		const arma::uword n = guess.n_elem;
+		myValues.set_size(n);
+		myJacobian.reset();
+		myStep.set_size(n);
+		myPoint.resize(n);
+		myPointValues.resize(n);
+
+		NewtonResult result;
+		result.iterations = 0;
+		result.converged = false;
+		result.cancelled = false;
+
+		//A guess that already solves the system (e.g. a warm start) costs one model evaluation and no iterations
+		for(arma::uword i = 0; i < n; i++)
+		{
+			myPoint[i] = guess[i];
+		}
+		myModel(myPoint, myPointValues);
+		for(arma::uword i = 0; i < n; i++)
+		{
+			myValues[i] = myPointValues[i];
+		}
+		result.error = arma::norm(targets - myValues, 2);
+
+		while(result.iterations < myMaxIterations and result.error > myErrorTolerance)
+		{
+			//myValues is F(guess) from the last evaluation, the policy only adds the Jacobian
+			myJacobian.set_size(n, n);
+			myJacobianPolicy(myModel, guess, myValues, myJacobian);
+
+			//J*v = F(x) - targets,  new guess = old guess - v
+			if(not myLinearSolver(myJacobian, myValues - targets, myStep))
+			{
+				return result;
+			}
+			guess -= myStep;
+
+			//F(x) with the updated guess, in plain doubles
+			for(arma::uword i = 0; i < n; i++)
+			{
+				myPoint[i] = guess[i];
+			}
+			myModel(myPoint, myPointValues);
+			for(arma::uword i = 0; i < n; i++)
+			{
+				myValues[i] = myPointValues[i];
+			}
+
+			result.error = arma::norm(targets - myValues, 2);
+			result.iterations++;
+
+			if(result.error > myErrorTolerance and not monitor(guess, result.error))
+			{
+				result.cancelled = true;
+				return result;
+			}
+		}
+		result.converged = result.error <= myErrorTolerance;
+		return result;
+	}
+
+	//Jacobian of the last iteration, empty if the last solve took none
+	const arma::Mat<double>& jacobian() const
+	{
+		return myJacobian;
+	}
+
+	//F at the guess the last solve returned
+	const arma::Col<double>& values() const
+	{
+		return myValues;
+	}
+
+private:
+	Model myModel;
+	JacobianPolicy myJacobianPolicy;
+	LinearSolverPolicy myLinearSolver;
+	int myMaxIterations;
+	double myErrorTolerance;
+	arma::Col<double> myValues;
+	arma::Mat<double> myJacobian;
+	arma::Col<double> myStep;
+	std::valarray<double> myPoint;
+	std::valarray<double> myPointValues;
+};
+
+#endif
@@ -0,0 +1,399 @@
+/*
+####Title:
+Example Newton Raphson Solver: Templated NewtonSolver with Forward Difference, Complex Step and AD Policies
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+Program solves the same intersection of three infinite paraboloids as forward_difference.cpp:
+
+(x-1)^2 + y^2 + z = 0
+x^2 + y^2 -(z+1) = 0
+x^2 + y^2 +(z-1) = 0
+
+They should intersect at the point (1, 0, 0)
+
+Instead of a hand-written main loop, it instantiates NewtonSolver (newton_solver.hpp) three times, once per
+JacobianPolicy, with one model, "ParaboloidModel". The model is written once as a template on the scalar type, so
+the forward difference policy evaluates it with double, the complex-step policy with std::complex<double> and the AD
+policy with Sacado::Fad::SFad. The unrolled fixed-size linear solver is used since NUMDIMENSIONS is known at
+compile time.
+
+This is the form meant for embedding the solver in other code: the model is a function object rather than
+a function pointer, and the three examples' Jacobian techniques are interchangeable template arguments.
+The modes of the individual examples (Broyden, modified Newton, Jacobian-free, ...) remain there.
+
+Finally "solveBatch" (batch_solver.hpp) solves NUMINSTANCES instances at once on a work-stealing ThreadPool.
+Instance i shifts the offsets by s_i, which moves the root to (1, sqrt(s_i), 0); the closer s_i is to 0 the
+closer the root is to being singular and the more iterations the instance takes, so the instances are
+deliberately uneven.
+
+With a shift s > 0 the system has two roots, (1, sqrt(s), 0) and (1, -sqrt(s), 0). "searchRoots" (multi_start.hpp)
+looks for all of them from a grid of NUMSTARTSPERAXIS^3 starting points in a box around the origin, first
+cancelling the starts that come within CAPTURERADIUS of a root already found, then without cancelling any,
+to show the iterations the cancellation saves.
+
+Lastly the shift is swept through NUMSWEEPVALUES values from SWEEPSTARTSHIFT to SWEEPENDSHIFT, first with every
+value cold-started from 2.0, then by natural-parameter continuation ("sweepParameter", continuation.hpp) with the
+secant and the tangent predictor, which warm-start each value from the solutions of the previous ones.
+
+To mimic a production stream of similar problems, NUMCACHEDSOLVES random shifts are then solved cold and through a
+SolutionCache (solution_cache.hpp) holding at most CACHECAPACITY solved problems: each solve starts from the
+nearest cached root and takes modified Newton steps with its cached Jacobian factors before computing Jacobians.
+A solve that converges on those factors alone still computes one Jacobian, at its own root, for the factors it
+caches, so every distinct shift costs at least one Jacobian; only an exact repeat of a cached shift costs none.
+
+####Dependencies:
+The "Armadillo" C++ API was chosen to handle the linear algebra tasks because of its clear syntax
+and integration with LAPACK. For a list of dependences and installation instructions for
+Armadillo refer to the Armadillo project page at sourceforge.net.
+
+As of 20 Aug. 2013, Armadillo can be obtained at: http://arma.sourceforge.net/
+
+The AD policy needs the Sacado package of Trilinos, see automatic_differentiation.cpp.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <valarray>
+#include <Teuchos_RCPNode.hpp>
+#include <Sacado.hpp>
+#include <armadillo>
+#include <vector>
+#include "batch_solver.hpp"
+#include "continuation.hpp"
+#include "multi_start.hpp"
+#include "newton_solver.hpp"
+#include "solution_cache.hpp"
+#include "thread_pool.hpp"
+
+const int NUMDIMENSIONS = 3;
+const int MAXITERATIONS = 9;
+const double ERRORTOLLERANCE = 1.0E-4;
+const double PROBEDISTANCE = 1.0E-10;
+const double COMPLEXPROBEDISTANCE = 1.0E-30;
+const int NUMINSTANCES = 10000;
+const int BATCHMAXITERATIONS = 30;
+const int NUMTHREADS = 4;
+const double MULTISTARTSHIFT = 1.0;
+const int NUMSTARTSPERAXIS = 8;
+const double STARTBOXHALFWIDTH = 3.0;
+const int MULTISTARTMAXITERATIONS = 30;
+const double DUPLICATETOLERANCE = 1.0E-3;
+const double CAPTURERADIUS = 0.1;
+const int NUMSWEEPVALUES = 2000;
+const double SWEEPSTARTSHIFT = 0.25;
+const double SWEEPENDSHIFT = 4.0;
+const int TARGETCORRECTORITERATIONS = 3;
+const double MINCONTINUATIONSTEP = 1.0E-6;
+const int NUMCACHEDSOLVES = 2000;
+const int CACHECAPACITY = 64;
+const int MAXCACHEDFACTORIZATIONSTEPS = 10;
+const double MAXCACHEDRESIDUALRATIO = 0.5;
+
+typedef Sacado::Fad::SFad<double, NUMDIMENSIONS>  SF;  // Forward AD with # of ind. vars fixed at compile time
+
+//This model is specific to a single problem
+class ParaboloidModel
+{
+public:
+	//Shifting the z offsets by shift >= 0 moves the root to (1, sqrt(shift), 0)
+	explicit ParaboloidModel(double shift = 0.0)
+	{
+		//Offsets of the paraboloids, one row per equation
+		const double offsets[NUMDIMENSIONS][NUMDIMENSIONS] = {{1.0, 0.0, shift}, {0.0, 0.0, 1.0 + shift}, {0.0, 0.0, 1.0 + shift}};
+		for(int i = 0; i < NUMDIMENSIONS; i++)
+		{
+			for(int k = 0; k < NUMDIMENSIONS; k++)
+			{
+				myOffsets[i][k] = offsets[i][k];
+			}
+		}
+	}
+
+	template <typename Scalar>
+	void operator()(const std::valarray<Scalar>& myCurrentGuess, std::valarray<Scalar>& targetsCalculated) const
+	{
+		Scalar difference;
+		for(int i = 0; i < NUMDIMENSIONS; i++)
+		{
+			targetsCalculated[i] = 0.0;
+			for(int k = 0; k < 2; k++)
+			{
+				difference = myCurrentGuess[k] - myOffsets[i][k];
+				targetsCalculated[i] += difference*difference;
+			}
+			targetsCalculated[i] = targetsCalculated[i] + myCurrentGuess[2]*pow(-1.0, i) - myOffsets[i][2];
+		}
+	}
+
+private:
+	double myOffsets[NUMDIMENSIONS][NUMDIMENSIONS];
+};
+
+template <class JacobianPolicy>
+void solveParaboloids(const char* myPolicyName,
+		      const JacobianPolicy& myJacobianPolicy);
+
+void solveShiftedParaboloids();
+
+void searchParaboloidRoots(double myCaptureRadius);
+
+void sweepParaboloidShift();
+
+void solveWithSolutionCache();
+
+int main(int argc, char* argv[])
+{
+	solveParaboloids("ForwardDifferenceJacobian", ForwardDifferenceJacobian(PROBEDISTANCE));
+	solveParaboloids("ComplexStepJacobian", ComplexStepJacobian(COMPLEXPROBEDISTANCE));
+	solveParaboloids("AutomaticDifferentiationJacobian<SFad>", AutomaticDifferentiationJacobian<SF>());
+	solveShiftedParaboloids();
+	searchParaboloidRoots(CAPTURERADIUS);
+	searchParaboloidRoots(0.0);
+	sweepParaboloidShift();
+	solveWithSolutionCache();
+	std::cout << "--program complete--" << std::endl;
+
+	return 0;
+}
+
+template <class JacobianPolicy>
+void solveParaboloids(const char* myPolicyName,
+		      const JacobianPolicy& myJacobianPolicy)
+{
+	//We need to initialize the target vector and provide an initial guess
+	arma::Col<double> targetsDesired(NUMDIMENSIONS);
+	targetsDesired.fill(0.0);
+
+	arma::Col<double> currentGuess(NUMDIMENSIONS);
+	currentGuess.fill(2.0);
+
+	typedef NewtonSolver<ParaboloidModel, JacobianPolicy, FixedSizeLinearSolver<NUMDIMENSIONS> > ParaboloidSolver;
+	ParaboloidSolver solver(ParaboloidModel(),
+				MAXITERATIONS,
+				ERRORTOLLERANCE,
+				myJacobianPolicy);
+
+	std::cout << "Running NewtonSolver with " << myPolicyName << " ..........." << std::endl;
+	NewtonResult result = solver.solve(currentGuess, targetsDesired);
+
+	std::cout << "******************************************" << std::endl;
+	std::cout << "Number of iterations: " << result.iterations << std::endl;
+	std::cout << "Final guess:\nx, y, z\n " << currentGuess.t();
+	std::cout << "Error tollerance: " << ERRORTOLLERANCE << std::endl;
+	std::cout << "Final error: " << result.error << std::endl;
+	if(not result.converged)
+	{
+		std::cout << "Not converged" << std::endl;
+	}
+}
+
+void solveShiftedParaboloids()
+{
+	//One model, initial guess and target vector per instance
+	std::vector<ParaboloidModel> models;
+	models.reserve(NUMINSTANCES);
+	for(int i = 0; i < NUMINSTANCES; i++)
+	{
+		models.push_back(ParaboloidModel(4.0*(i + 1)/NUMINSTANCES));
+	}
+	arma::Mat<double> initialGuesses(NUMDIMENSIONS, NUMINSTANCES);
+	initialGuesses.fill(2.0);
+	arma::Mat<double> targets(NUMDIMENSIONS, NUMINSTANCES);
+	targets.fill(0.0);
+
+	ThreadPool threadPool(NUMTHREADS);
+	arma::Mat<double> solutions;
+	std::vector<NewtonResult> results;
+
+	std::cout << "Running batch of " << NUMINSTANCES << " shifted paraboloid problems ..........." << std::endl;
+	if(not solveBatch(threadPool,
+			  models,
+			  initialGuesses,
+			  targets,
+			  BATCHMAXITERATIONS,
+			  ERRORTOLLERANCE,
+			  ForwardDifferenceJacobian(PROBEDISTANCE),
+			  FixedSizeLinearSolver<NUMDIMENSIONS>(),
+			  solutions,
+			  results))
+	{
+		std::cout << "The guesses and targets of the batch do not match its models" << std::endl;
+		return;
+	}
+
+	int numConverged = 0;
+	int fewestIterations = BATCHMAXITERATIONS;
+	int mostIterations = 0;
+	long totalIterations = 0;
+	for(int i = 0; i < NUMINSTANCES; i++)
+	{
+		numConverged += results[i].converged ? 1 : 0;
+		fewestIterations = std::min(fewestIterations, results[i].iterations);
+		mostIterations = std::max(mostIterations, results[i].iterations);
+		totalIterations += results[i].iterations;
+	}
+
+	std::cout << "******************************************" << std::endl;
+	std::cout << "Converged instances: " << numConverged << " of " << NUMINSTANCES << std::endl;
+	std::cout << "Iterations per instance: " << fewestIterations << " to " << mostIterations
+		  << ", " << double(totalIterations)/NUMINSTANCES << " on average" << std::endl;
+	std::cout << "Last instance, x, y, z:\n " << solutions.col(NUMINSTANCES - 1).t();
+	std::cout << "expected y = sqrt(4) = 2" << std::endl;
+}
+
+void searchParaboloidRoots(double myCaptureRadius)
+{
+	//Starting points on a regular grid, none of them on the singular plane y = 0
+	const int numStarts = NUMSTARTSPERAXIS*NUMSTARTSPERAXIS*NUMSTARTSPERAXIS;
+	const double spacing = 2.0*STARTBOXHALFWIDTH/(NUMSTARTSPERAXIS - 1);
+	arma::Mat<double> startingPoints(NUMDIMENSIONS, numStarts);
+	for(int i = 0; i < numStarts; i++)
+	{
+		startingPoints(0, i) = -STARTBOXHALFWIDTH + spacing*(i % NUMSTARTSPERAXIS);
+		startingPoints(1, i) = -STARTBOXHALFWIDTH + spacing*((i/NUMSTARTSPERAXIS) % NUMSTARTSPERAXIS);
+		startingPoints(2, i) = -STARTBOXHALFWIDTH + spacing*(i/(NUMSTARTSPERAXIS*NUMSTARTSPERAXIS));
+	}
+	arma::Col<double> targets(NUMDIMENSIONS);
+	targets.fill(0.0);
+
+	ThreadPool threadPool(NUMTHREADS);
+	RootSet roots(CAPTURERADIUS);
+
+	std::cout << "Running multi-start root search from " << numStarts << " starting points, capture radius "
+		  << myCaptureRadius << " ..........." << std::endl;
+	MultiStartResult result = searchRoots(threadPool,
+					      ParaboloidModel(MULTISTARTSHIFT),
+					      startingPoints,
+					      targets,
+					      MULTISTARTMAXITERATIONS,
+					      ERRORTOLLERANCE,
+					      DUPLICATETOLERANCE,
+					      myCaptureRadius,
+					      ForwardDifferenceJacobian(PROBEDISTANCE),
+					      FixedSizeLinearSolver<NUMDIMENSIONS>(),
+					      roots);
+
+	std::cout << "******************************************" << std::endl;
+	std::cout << "Distinct roots: " << result.numRoots << std::endl;
+	for(int i = 0; i < roots.size(); i++)
+	{
+		std::cout << " " << roots.root(i).t();
+	}
+	std::cout << "Duplicate roots: " << result.numDuplicates << std::endl;
+	std::cout << "Cancelled starts: " << result.numCancelled << std::endl;
+	std::cout << "Failed starts: " << result.numFailed << std::endl;
+	std::cout << "Total iterations: " << result.totalIterations << std::endl;
+}
+
+void sweepParaboloidShift()
+{
+	arma::Col<double> shifts = arma::linspace<arma::Col<double> >(SWEEPSTARTSHIFT, SWEEPENDSHIFT, NUMSWEEPVALUES);
+	arma::Col<double> initialGuess(NUMDIMENSIONS);
+	initialGuess.fill(2.0);
+	arma::Col<double> targets(NUMDIMENSIONS);
+	targets.fill(0.0);
+
+	typedef NewtonSolver<ParaboloidModel, ForwardDifferenceJacobian, FixedSizeLinearSolver<NUMDIMENSIONS> > ParaboloidSolver;
+	std::cout << "Running sweep of " << NUMSWEEPVALUES << " shifts, cold starts ..........." << std::endl;
+	long coldIterations = 0;
+	for(int k = 0; k < NUMSWEEPVALUES; k++)
+	{
+		ParaboloidSolver solver(ParaboloidModel(shifts[k]), BATCHMAXITERATIONS, ERRORTOLLERANCE, ForwardDifferenceJacobian(PROBEDISTANCE));
+		arma::Col<double> guess = initialGuess;
+		coldIterations += solver.solve(guess, targets).iterations;
+	}
+	std::cout << "******************************************" << std::endl;
+	std::cout << "Total iterations: " << coldIterations << std::endl;
+
+	auto paraboloidFamily = [](double shift) { return ParaboloidModel(shift); };
+	const ContinuationPredictor predictors[2] = {SECANT, TANGENT};
+	const char* predictorNames[2] = {"secant", "tangent"};
+	for(int p = 0; p < 2; p++)
+	{
+		arma::Mat<double> solutions;
+		std::vector<NewtonResult> results;
+		std::cout << "Running sweep of " << NUMSWEEPVALUES << " shifts, continuation with the "
+			  << predictorNames[p] << " predictor ..........." << std::endl;
+		ContinuationResult result = sweepParameter(paraboloidFamily,
+							   shifts,
+							   initialGuess,
+							   targets,
+							   BATCHMAXITERATIONS,
+							   ERRORTOLLERANCE,
+							   predictors[p],
+							   TARGETCORRECTORITERATIONS,
+							   MINCONTINUATIONSTEP,
+							   ForwardDifferenceJacobian(PROBEDISTANCE),
+							   FixedSizeLinearSolver<NUMDIMENSIONS>(),
+							   solutions,
+							   results);
+
+		std::cout << "******************************************" << std::endl;
+		if(not result.completed)
+		{
+			std::cout << "Sweep abandoned, the step size dropped below " << MINCONTINUATIONSTEP << std::endl;
+		}
+		std::cout << "Steps: " << result.numSteps << ", rejected: " << result.numRejectedSteps << std::endl;
+		std::cout << "Total iterations: " << result.totalIterations << std::endl;
+		std::cout << "Last shift, x, y, z:\n " << solutions.col(NUMSWEEPVALUES - 1).t();
+		std::cout << "expected y = sqrt(" << SWEEPENDSHIFT << ") = " << std::sqrt(SWEEPENDSHIFT) << std::endl;
+	}
+}
+
+void solveWithSolutionCache()
+{
+	arma::Col<double> shifts = SWEEPSTARTSHIFT + (SWEEPENDSHIFT - SWEEPSTARTSHIFT)*arma::randu<arma::Col<double> >(NUMCACHEDSOLVES);
+	arma::Col<double> targets(NUMDIMENSIONS);
+	targets.fill(0.0);
+
+	typedef NewtonSolver<ParaboloidModel, ForwardDifferenceJacobian, FixedSizeLinearSolver<NUMDIMENSIONS> > ParaboloidSolver;
+	std::cout << "Running " << NUMCACHEDSOLVES << " random shifts, cold starts ..........." << std::endl;
+	long coldIterations = 0;
+	for(int k = 0; k < NUMCACHEDSOLVES; k++)
+	{
+		ParaboloidSolver solver(ParaboloidModel(shifts[k]), BATCHMAXITERATIONS, ERRORTOLLERANCE, ForwardDifferenceJacobian(PROBEDISTANCE));
+		arma::Col<double> guess(NUMDIMENSIONS);
+		guess.fill(2.0);
+		coldIterations += solver.solve(guess, targets).iterations;
+	}
+	std::cout << "******************************************" << std::endl;
+	std::cout << "Total iterations: " << coldIterations << ", all with a new Jacobian" << std::endl;
+
+	SolutionCache cache(CACHECAPACITY);
+	std::cout << "Running " << NUMCACHEDSOLVES << " random shifts through a solution cache of "
+		  << CACHECAPACITY << " entries ..........." << std::endl;
+	int numConverged = 0;
+	int numCacheHits = 0;
+	long cachedIterations = 0;
+	long cachedJacobians = 0;
+	for(int k = 0; k < NUMCACHEDSOLVES; k++)
+	{
+		//A cache miss starts from the usual guess
+		arma::Col<double> guess(NUMDIMENSIONS);
+		guess.fill(2.0);
+		arma::Col<double> parameters(1);
+		parameters[0] = shifts[k];
+		CachedSolveResult result = solveWithCache(cache,
+							  parameters,
+							  ParaboloidModel(shifts[k]),
+							  guess,
+							  targets,
+							  BATCHMAXITERATIONS,
+							  ERRORTOLLERANCE,
+							  FactorizationReusePolicy(MAXCACHEDFACTORIZATIONSTEPS, MAXCACHEDRESIDUALRATIO),
+							  ForwardDifferenceJacobian(PROBEDISTANCE),
+							  FixedSizeLinearSolver<NUMDIMENSIONS>());
+		numConverged += result.converged ? 1 : 0;
+		numCacheHits += result.cacheHit ? 1 : 0;
+		cachedIterations += result.iterations;
+		cachedJacobians += result.jacobians;
+	}
+	std::cout << "******************************************" << std::endl;
+	std::cout << "Converged: " << numConverged << " of " << NUMCACHEDSOLVES << ", cache hits: " << numCacheHits << std::endl;
+	std::cout << "Total iterations: " << cachedIterations << ", " << cachedJacobians << " with a new Jacobian" << std::endl;
+	std::cout << "Cached problems: " << cache.size() << std::endl;
+}
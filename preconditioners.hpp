@@ -0,0 +1,242 @@
+/*
+####Title:
+Preconditioners for the Krylov Linear Solvers
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+A preconditioner is an approximation M of the Jacobian whose inverse is cheap to apply. "solveGMRES" and
+"solveBiCGStab" (krylov_solvers.hpp) then solve J*inverse(M)*y = F instead of J*v = F, which takes far fewer
+iterations when M is close to J. Every preconditioner here is built from an assembled SparseJacobian
+(sparse_jacobian.hpp), never forms a dense NUMDIMENSIONS x NUMDIMENSIONS matrix, and has no fill-in:
+
+-JacobiPreconditioner: M = diag(J). O(NUMDIMENSIONS) to build and apply, enough for diagonally dominant Jacobians.
+-ILU0Preconditioner: incomplete LU with zero fill, M = L*U where L and U keep exactly the sparsity pattern of J and
+ every entry that LU would create outside of it is dropped. Usually the most effective of the three.
+-BlockJacobiPreconditioner: M = the diagonal blocks of J of size blockSize, each factored densely by BlockDiagonalLU
+ (structured_solvers.hpp), which drops the entries outside of them. Suits problems whose unknowns come in tightly
+ coupled groups. A blockSize of 0 makes the whole Jacobian one block.
+
+"build" computes the preconditioner from a Jacobian; "apply" sets preconditioned ~= inverse(M) * residual.
+Building costs much more than applying, so the main loop keeps a preconditioner across Newton iterations
+(FactorizationReusePolicy) and only rebuilds it once convergence degrades.
+*/
+
+#ifndef PRECONDITIONERS_HPP
+#define PRECONDITIONERS_HPP
+
+#include <algorithm>
+#include <vector>
+#include <armadillo>
+#include "sparse_jacobian.hpp"
+#include "structured_solvers.hpp"
+
+class Preconditioner
+{
+public:
+	virtual ~Preconditioner()
+	{
+	}
+
+	//False if the preconditioner cannot be built, e.g. because of a zero pivot
+	virtual bool build(const SparseJacobian& jacobian) = 0;
+
+	virtual void apply(const arma::Col<double>& residual, arma::Col<double>& preconditioned) const = 0;
+
+	//So a preconditioner can be handed straight to solveGMRES and solveBiCGStab
+	void operator()(const arma::Col<double>& residual, arma::Col<double>& preconditioned) const
+	{
+		apply(residual, preconditioned);
+	}
+};
+
+class JacobiPreconditioner : public Preconditioner
+{
+public:
+	bool build(const SparseJacobian& jacobian)
+	{
+		const arma::Col<arma::uword>& rowIndices = jacobian.rowIndices();
+		const arma::Col<arma::uword>& columnPointers = jacobian.columnPointers();
+		myInverseDiagonal.zeros(jacobian.numColumns());
+		for(arma::uword j = 0; j < jacobian.numColumns(); j++)
+		{
+			for(arma::uword k = columnPointers[j]; k < columnPointers[j + 1]; k++)
+			{
+				if(rowIndices[k] == j and jacobian.values()[k] != 0.0)
+				{
+					myInverseDiagonal[j] = 1.0/jacobian.values()[k];
+				}
+			}
+			if(myInverseDiagonal[j] == 0.0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void apply(const arma::Col<double>& residual, arma::Col<double>& preconditioned) const
+	{
+		preconditioned = myInverseDiagonal % residual;
+	}
+
+private:
+	arma::Col<double> myInverseDiagonal;
+};
+
+class ILU0Preconditioner : public Preconditioner
+{
+public:
+	bool build(const SparseJacobian& jacobian)
+	{
+		//ILU(0) works row by row, so the CSC pattern is transposed into compressed sparse rows first
+		//Scanning the columns in order leaves the column indices of every row sorted
+		const arma::Col<arma::uword>& rowIndices = jacobian.rowIndices();
+		const arma::Col<arma::uword>& columnPointers = jacobian.columnPointers();
+		const arma::uword n = jacobian.numRows();
+		const arma::uword numNonzeros = jacobian.numNonzeros();
+
+		myRowPointers.assign(n + 1, 0);
+		for(arma::uword k = 0; k < numNonzeros; k++)
+		{
+			myRowPointers[rowIndices[k] + 1]++;
+		}
+		for(arma::uword i = 0; i < n; i++)
+		{
+			myRowPointers[i + 1] += myRowPointers[i];
+		}
+		myColumnIndices.resize(numNonzeros);
+		myFactors.resize(numNonzeros);
+		std::vector<arma::uword> nextInRow(myRowPointers.begin(), myRowPointers.end() - 1);
+		for(arma::uword j = 0; j < jacobian.numColumns(); j++)
+		{
+			for(arma::uword k = columnPointers[j]; k < columnPointers[j + 1]; k++)
+			{
+				arma::uword position = nextInRow[rowIndices[k]]++;
+				myColumnIndices[position] = j;
+				myFactors[position] = jacobian.values()[k];
+			}
+		}
+
+		//Position of the diagonal entry in every row, it has to be part of the pattern
+		myDiagonal.resize(n);
+		for(arma::uword i = 0; i < n; i++)
+		{
+			myDiagonal[i] = myRowPointers[i + 1];
+			for(arma::uword k = myRowPointers[i]; k < myRowPointers[i + 1]; k++)
+			{
+				if(myColumnIndices[k] == i)
+				{
+					myDiagonal[i] = k;
+				}
+			}
+			if(myDiagonal[i] == myRowPointers[i + 1])
+			{
+				return false;
+			}
+		}
+
+		//Gaussian elimination restricted to the pattern (IKJ order)
+		//positionInRow[j] is where column j sits in the current row i, or -1 if it is not in the pattern
+		std::vector<long> positionInRow(n, -1);
+		for(arma::uword i = 0; i < n; i++)
+		{
+			for(arma::uword k = myRowPointers[i]; k < myRowPointers[i + 1]; k++)
+			{
+				positionInRow[myColumnIndices[k]] = long(k);
+			}
+
+			for(arma::uword k = myRowPointers[i]; k < myDiagonal[i]; k++)
+			{
+				arma::uword pivotRow = myColumnIndices[k];
+				myFactors[k] /= myFactors[myDiagonal[pivotRow]];
+				for(arma::uword l = myDiagonal[pivotRow] + 1; l < myRowPointers[pivotRow + 1]; l++)
+				{
+					long position = positionInRow[myColumnIndices[l]];
+					if(position >= 0)
+					{
+						myFactors[position] -= myFactors[k]*myFactors[l];
+					}
+				}
+			}
+
+			for(arma::uword k = myRowPointers[i]; k < myRowPointers[i + 1]; k++)
+			{
+				positionInRow[myColumnIndices[k]] = -1;
+			}
+
+			//U_ii is final once row i is eliminated, and both later rows and "apply" divide by it
+			if(myFactors[myDiagonal[i]] == 0.0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void apply(const arma::Col<double>& residual, arma::Col<double>& preconditioned) const
+	{
+		//L has a unit diagonal and is stored below myDiagonal, U from myDiagonal on
+		const arma::uword n = myDiagonal.size();
+		preconditioned = residual;
+		for(arma::uword i = 0; i < n; i++)
+		{
+			for(arma::uword k = myRowPointers[i]; k < myDiagonal[i]; k++)
+			{
+				preconditioned[i] -= myFactors[k]*preconditioned[myColumnIndices[k]];
+			}
+		}
+		for(arma::uword i = n; i-- > 0; )
+		{
+			for(arma::uword k = myDiagonal[i] + 1; k < myRowPointers[i + 1]; k++)
+			{
+				preconditioned[i] -= myFactors[k]*preconditioned[myColumnIndices[k]];
+			}
+			preconditioned[i] /= myFactors[myDiagonal[i]];
+		}
+	}
+
+private:
+	std::vector<arma::uword> myRowPointers;
+	std::vector<arma::uword> myColumnIndices;
+	std::vector<arma::uword> myDiagonal;
+	std::vector<double> myFactors;
+};
+
+class BlockJacobiPreconditioner : public Preconditioner
+{
+public:
+	//No blocks until the first "build"; a blockSize of 0 makes all unknowns one block
+	explicit BlockJacobiPreconditioner(arma::uword blockSize)
+		: myBlockSize(blockSize), myBlocks(std::vector<arma::uword>(1, 0))
+	{
+	}
+
+	bool build(const SparseJacobian& jacobian)
+	{
+		//Consecutive unknowns are grouped, the last block may be smaller
+		const arma::uword n = jacobian.numColumns();
+		const arma::uword blockSize = (myBlockSize > 0) ? myBlockSize : std::max(n, arma::uword(1));
+		std::vector<arma::uword> blockStarts;
+		for(arma::uword first = 0; first < n; first += blockSize)
+		{
+			blockStarts.push_back(first);
+		}
+		blockStarts.push_back(n);
+
+		myBlocks = BlockDiagonalLU(blockStarts);
+		return myBlocks.factor(jacobian);
+	}
+
+	void apply(const arma::Col<double>& residual, arma::Col<double>& preconditioned) const
+	{
+		myBlocks.solve(residual, preconditioned);
+	}
+
+private:
+	arma::uword myBlockSize;
+	BlockDiagonalLU myBlocks;
+};
+
+#endif
@@ -0,0 +1,129 @@
+/*
+####Title:
+Fixed-Size Linear Solver for Small Newton Raphson Systems
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+For a 3x3 Jacobian, "solve(myJacobian, ...)" spends more time allocating temporaries and dispatching to LAPACK
+than doing the arithmetic. LinearSolver<N>::solve picks the method for an N x N system at compile time:
+-N <= MAXSMALLSYSTEMDIMENSION: Gaussian elimination with partial pivoting (LU applied to the right hand side as it is
+ factored) on N x N stack arrays. Every loop has a compile-time trip count, so the compiler unrolls it completely;
+ nothing is allocated and no library is called.
+-Larger N: the general Armadillo solve.
+
+Both return false if the system is singular, like the bool form of arma::solve, or if myMatrix is not N x N or
+myRightHandSide does not hold N elements. The solution is written into mySolution, which is resized to N elements.
+*/
+
+#ifndef SMALL_LINEAR_SOLVER_HPP
+#define SMALL_LINEAR_SOLVER_HPP
+
+#include <cmath>
+#include <armadillo>
+
+const int MAXSMALLSYSTEMDIMENSION = 8;
+
+template <int N, bool IsSmall = (N <= MAXSMALLSYSTEMDIMENSION)>
+struct LinearSolver
+{
+	static bool solve(const arma::Mat<double>& myMatrix,
+			  const arma::Col<double>& myRightHandSide,
+			  arma::Col<double>& mySolution)
+	{
+		if(myMatrix.n_rows != arma::uword(N) or myMatrix.n_cols != arma::uword(N) or myRightHandSide.n_elem != arma::uword(N))
+		{
+			return false;
+		}
+		return arma::solve(mySolution, myMatrix, myRightHandSide);
+	}
+};
+
+template <int N>
+struct LinearSolver<N, true>
+{
+	static bool solve(const arma::Mat<double>& myMatrix,
+			  const arma::Col<double>& myRightHandSide,
+			  arma::Col<double>& mySolution)
+	{
+		//The stack arrays below are N x N, anything else would be read out of bounds
+		if(myMatrix.n_rows != arma::uword(N) or myMatrix.n_cols != arma::uword(N) or myRightHandSide.n_elem != arma::uword(N))
+		{
+			return false;
+		}
+
+		//Row-major copy on the stack, Armadillo stores columns contiguously
+		const double* matrixValues = myMatrix.memptr();
+		double factors[N][N];
+		double solution[N];
+		for(int i = 0; i < N; i++)
+		{
+			for(int j = 0; j < N; j++)
+			{
+				factors[i][j] = matrixValues[i + j*N];
+			}
+			solution[i] = myRightHandSide[i];
+		}
+
+		for(int k = 0; k < N; k++)
+		{
+			//Partial pivoting: bring the largest remaining entry of column k onto the diagonal
+			int pivot = k;
+			for(int i = k + 1; i < N; i++)
+			{
+				if(std::fabs(factors[i][k]) > std::fabs(factors[pivot][k]))
+				{
+					pivot = i;
+				}
+			}
+			if(factors[pivot][k] == 0.0)
+			{
+				return false;
+			}
+			if(pivot != k)
+			{
+				for(int j = 0; j < N; j++)
+				{
+					double temp = factors[k][j];
+					factors[k][j] = factors[pivot][j];
+					factors[pivot][j] = temp;
+				}
+				double temp = solution[k];
+				solution[k] = solution[pivot];
+				solution[pivot] = temp;
+			}
+
+			//Eliminate column k below the diagonal, carrying the right hand side along
+			double inversePivot = 1.0/factors[k][k];
+			for(int i = k + 1; i < N; i++)
+			{
+				double multiplier = factors[i][k]*inversePivot;
+				for(int j = k + 1; j < N; j++)
+				{
+					factors[i][j] -= multiplier*factors[k][j];
+				}
+				solution[i] -= multiplier*solution[k];
+			}
+		}
+
+		//Back substitution with the upper triangular factor
+		for(int i = N - 1; i >= 0; i--)
+		{
+			for(int j = i + 1; j < N; j++)
+			{
+				solution[i] -= factors[i][j]*solution[j];
+			}
+			solution[i] /= factors[i][i];
+		}
+
+		mySolution.set_size(N);
+		for(int i = 0; i < N; i++)
+		{
+			mySolution[i] = solution[i];
+		}
+		return true;
+	}
+};
+
+#endif
@@ -0,0 +1,104 @@
+/*
+####Title:
+Benchmark: Fixed-Size Linear Solver for Small Newton Raphson Systems
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+Compares two ways of solving the N x N system J*v = F(x) of a Newton Raphson step:
+
+1)"solve" from Armadillo, the general path every example used before, which goes through LAPACK
+2)"LinearSolver<N>::solve" from small_linear_solver.hpp, pivoted elimination on stack arrays unrolled at compile time
+
+For N = 3 (the paraboloid examples) and N = MAXSMALLSYSTEMDIMENSION, NUMSYSTEMS random diagonally dominant systems
+are solved with both methods and the solutions compared, then each method is timed over REPETITIONS passes.
+
+####Dependencies:
+Armadillo, see forward_difference.cpp.
+The timing uses std::chrono, so compile with -std=c++11.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <armadillo>
+#include "small_linear_solver.hpp"
+
+const int NUMSYSTEMS = 64;
+const int REPETITIONS = 10000;
+
+template <int N>
+void benchmarkDimension();
+
+int main(int argc, char* argv[])
+{
+	std::cout << "Running small linear solver benchmark ................" << std::endl;
+	benchmarkDimension<3>();
+	benchmarkDimension<MAXSMALLSYSTEMDIMENSION>();
+	std::cout << "--program complete--" << std::endl;
+
+	return 0;
+}
+
+template <int N>
+void benchmarkDimension()
+{
+	//Diagonally dominant, so every system is comfortably nonsingular
+	std::vector<arma::Mat<double> > matrices(NUMSYSTEMS);
+	std::vector<arma::Col<double> > rightHandSides(NUMSYSTEMS);
+	for(int s = 0; s < NUMSYSTEMS; s++)
+	{
+		matrices[s] = arma::randu<arma::Mat<double> >(N, N);
+		for(int i = 0; i < N; i++)
+		{
+			matrices[s](i, i) += double(N);
+		}
+		rightHandSides[s] = arma::randu<arma::Col<double> >(N);
+	}
+
+	arma::Col<double> generalSolution(N);
+	arma::Col<double> smallSolution(N);
+
+	//Both methods must produce the same solutions
+	double largestDifference = 0.0;
+	for(int s = 0; s < NUMSYSTEMS; s++)
+	{
+		arma::solve(generalSolution, matrices[s], rightHandSides[s]);
+		LinearSolver<N>::solve(matrices[s], rightHandSides[s], smallSolution);
+		largestDifference = std::max(largestDifference, arma::abs(generalSolution - smallSolution).max());
+	}
+
+	//Accumulate the solutions so the solves cannot be optimized away
+	double checksum = 0.0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(int r = 0; r < REPETITIONS; r++)
+	{
+		for(int s = 0; s < NUMSYSTEMS; s++)
+		{
+			arma::solve(generalSolution, matrices[s], rightHandSides[s]);
+			checksum += generalSolution[0];
+		}
+	}
+	double generalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	start = std::chrono::steady_clock::now();
+	for(int r = 0; r < REPETITIONS; r++)
+	{
+		for(int s = 0; s < NUMSYSTEMS; s++)
+		{
+			LinearSolver<N>::solve(matrices[s], rightHandSides[s], smallSolution);
+			checksum -= smallSolution[0];
+		}
+	}
+	double smallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	double solves = double(REPETITIONS)*NUMSYSTEMS;
+	std::cout << "******************************************" << std::endl;
+	std::cout << "System size: " << N << " x " << N << ", solves per method: " << solves << std::endl;
+	std::cout << "Largest difference between the two solutions: " << largestDifference << std::endl;
+	std::cout << "Armadillo solve:  " << 1.0E9*generalSeconds/solves << " nanoseconds per solve" << std::endl;
+	std::cout << "Fixed-size solve: " << 1.0E9*smallSeconds/solves << " nanoseconds per solve" << std::endl;
+	std::cout << "Speedup: " << generalSeconds/smallSeconds << " (checksum " << checksum << ")" << std::endl;
+}
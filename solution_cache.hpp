@@ -0,0 +1,412 @@
+/*
+####Title:
+Warm-Start Cache of Newton Raphson Solutions Keyed by Problem Parameters
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+When systems are solved over and over with parameters (offsets, shifts, ...) close to ones already solved, the
+root of the nearest solved problem is a far better initial guess than a fixed one, and the Jacobian factored
+there is usually still good enough for modified Newton steps.
+
+SolutionCache stores, per solved problem, its parameter vector, its root and the LU factors of its final Jacobian
+(lu_factorization.hpp). The entries are indexed by a k-d tree over the parameter vectors, so "findNearest" visits
+O(log(size)) entries instead of all of them. Memory is bounded by capacity: inserting into a full cache evicts
+the least recently used entry, where both insertion and being returned by "findNearest" count as a use.
+An evicted entry's k-d tree node stays in place to keep the tree's splits valid and is only skipped; once the
+dead nodes outnumber the live ones the tree is rebuilt, balanced, from the live entries.
+All member functions lock a mutex, so one cache can be shared by several threads.
+
+"solveWithCache" is the solve that goes through the cache:
+1)start from the root of the nearest cached problem, if any
+2)take modified Newton steps with its stored factors while FactorizationReusePolicy accepts them, one model
+ evaluation per step and no Jacobian
+3)finish with NewtonSolver (newton_solver.hpp) if that did not converge
+4)insert the root and the factors of the final Jacobian into the cache; when no Newton iteration ran, the
+ factors used were the neighbour's, so the Jacobian is computed and factored once more at the new root rather
+ than passing stale factors down a chain of nearby solves
+All parameter vectors of one cache have the same length, fixed by the first insertion. "findNearest" finds
+nothing and "insert" stores nothing for a vector of any other length.
+A problem whose parameters are within keyTolerance (0 by default, exact matches only) of a cached one replaces that
+entry's root and factors in place instead of adding a second entry, so re-solving the same problems never crowds
+the distinct ones out of the cache. A solve that starts on an exact hit and needs no step at all keeps the cached
+factors and neither computes a Jacobian nor touches the cache beyond the lookup.
+*/
+
+#ifndef SOLUTION_CACHE_HPP
+#define SOLUTION_CACHE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <valarray>
+#include <vector>
+#include <armadillo>
+#include "lu_factorization.hpp"
+#include "newton_solver.hpp"
+
+class SolutionCache
+{
+public:
+	explicit SolutionCache(int capacity, double keyTolerance = 0.0)
+		: myCapacity(capacity), myKeyTolerance(keyTolerance), myDimension(0), myRoot(-1), myNumDeadNodes(0)
+	{
+	}
+
+	int size() const
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		return int(myRecency.size());
+	}
+
+	//Copies the root and factors of the cached problem nearest to parameters, in the L2 norm
+	//False if the cache is empty or parameters does not have the cache's dimension
+	bool findNearest(const arma::Col<double>& parameters,
+			 arma::Col<double>& solution,
+			 LUFactorization& factors,
+			 double& distance)
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		if(parameters.n_elem != myDimension)
+		{
+			return false;
+		}
+		int nearest = -1;
+		double nearestSquaredDistance = std::numeric_limits<double>::infinity();
+		searchNearest(myRoot, parameters, nearest, nearestSquaredDistance);
+		if(nearest < 0)
+		{
+			return false;
+		}
+
+		Entry& entry = myEntries[myNodes[nearest].entry];
+		myRecency.splice(myRecency.begin(), myRecency, entry.recency);
+		solution = entry.solution;
+		factors = entry.factors;
+		distance = std::sqrt(nearestSquaredDistance);
+		return true;
+	}
+
+	//Adds a solved problem, evicting the least recently used one if the cache is full
+	//A cached problem within keyTolerance of parameters is overwritten instead, keeping its key
+	//False, and nothing stored, if parameters is empty or does not have the dimension of the earlier insertions
+	bool insert(const arma::Col<double>& parameters,
+		    const arma::Col<double>& solution,
+		    const LUFactorization& factors)
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		if(myCapacity <= 0 or parameters.n_elem == 0 or (myDimension > 0 and parameters.n_elem != myDimension))
+		{
+			return false;
+		}
+		myDimension = parameters.n_elem;
+
+		int nearest = -1;
+		double nearestSquaredDistance = std::numeric_limits<double>::infinity();
+		searchNearest(myRoot, parameters, nearest, nearestSquaredDistance);
+		if(nearest >= 0 and std::sqrt(nearestSquaredDistance) <= myKeyTolerance)
+		{
+			Entry& entry = myEntries[myNodes[nearest].entry];
+			entry.solution = solution;
+			entry.factors = factors;
+			myRecency.splice(myRecency.begin(), myRecency, entry.recency);
+			return true;
+		}
+
+		int slot;
+		if(int(myRecency.size()) == myCapacity)
+		{
+			slot = myRecency.back();
+			myRecency.pop_back();
+			myNodes[myEntries[slot].node].entry = -1;
+			myNumDeadNodes++;
+		}
+		else
+		{
+			slot = int(myEntries.size());
+			myEntries.push_back(Entry());
+		}
+
+		Entry& entry = myEntries[slot];
+		entry.parameters = parameters;
+		entry.solution = solution;
+		entry.factors = factors;
+		myRecency.push_front(slot);
+		entry.recency = myRecency.begin();
+		entry.node = insertNode(slot);
+
+		if(myNumDeadNodes > int(myRecency.size()))
+		{
+			rebuild();
+		}
+		return true;
+	}
+
+private:
+	struct Entry
+	{
+		arma::Col<double> parameters;
+		arma::Col<double> solution;
+		LUFactorization factors;
+		std::list<int>::iterator recency;
+		int node;
+	};
+
+	//entry is -1 once the entry has been evicted
+	struct Node
+	{
+		int entry;
+		arma::uword dimension;
+		double split;
+		int left;
+		int right;
+	};
+
+	int newNode(int slot, arma::uword dimension)
+	{
+		Node node;
+		node.entry = slot;
+		node.dimension = dimension;
+		node.split = myEntries[slot].parameters[dimension];
+		node.left = -1;
+		node.right = -1;
+		myNodes.push_back(node);
+		return int(myNodes.size()) - 1;
+	}
+
+	int insertNode(int slot)
+	{
+		const arma::Col<double>& key = myEntries[slot].parameters;
+		if(myRoot < 0)
+		{
+			myRoot = newNode(slot, 0);
+			return myRoot;
+		}
+
+		int current = myRoot;
+		while(true)
+		{
+			//Read the fields before newNode can reallocate myNodes
+			arma::uword childDimension = (myNodes[current].dimension + 1) % key.n_elem;
+			bool goLeft = key[myNodes[current].dimension] < myNodes[current].split;
+			int child = goLeft ? myNodes[current].left : myNodes[current].right;
+			if(child < 0)
+			{
+				int added = newNode(slot, childDimension);
+				if(goLeft)
+				{
+					myNodes[current].left = added;
+				}
+				else
+				{
+					myNodes[current].right = added;
+				}
+				return added;
+			}
+			current = child;
+		}
+	}
+
+	void searchNearest(int node, const arma::Col<double>& key, int& nearest, double& nearestSquaredDistance) const
+	{
+		if(node < 0)
+		{
+			return;
+		}
+		const Node& current = myNodes[node];
+		if(current.entry >= 0)
+		{
+			arma::Col<double> difference = myEntries[current.entry].parameters - key;
+			double squaredDistance = arma::dot(difference, difference);
+			if(squaredDistance < nearestSquaredDistance)
+			{
+				nearestSquaredDistance = squaredDistance;
+				nearest = node;
+			}
+		}
+
+		//The far side can only hold something nearer if the splitting plane is nearer than the best so far
+		double offset = key[current.dimension] - current.split;
+		searchNearest(offset < 0.0 ? current.left : current.right, key, nearest, nearestSquaredDistance);
+		if(offset*offset < nearestSquaredDistance)
+		{
+			searchNearest(offset < 0.0 ? current.right : current.left, key, nearest, nearestSquaredDistance);
+		}
+	}
+
+	//Balanced subtree over slots[begin, end), split at the median of each level's dimension
+	int buildBalanced(std::vector<int>& slots, int begin, int end, arma::uword dimension)
+	{
+		if(begin >= end)
+		{
+			return -1;
+		}
+		int middle = begin + (end - begin)/2;
+		std::nth_element(slots.begin() + begin, slots.begin() + middle, slots.begin() + end, [&](int a, int b)
+		{
+			return myEntries[a].parameters[dimension] < myEntries[b].parameters[dimension];
+		});
+
+		int node = newNode(slots[middle], dimension);
+		myEntries[slots[middle]].node = node;
+		arma::uword childDimension = (dimension + 1) % myEntries[slots[middle]].parameters.n_elem;
+		int left = buildBalanced(slots, begin, middle, childDimension);
+		int right = buildBalanced(slots, middle + 1, end, childDimension);
+		myNodes[node].left = left;
+		myNodes[node].right = right;
+		return node;
+	}
+
+	void rebuild()
+	{
+		std::vector<int> slots(myRecency.begin(), myRecency.end());
+		myNodes.clear();
+		myNumDeadNodes = 0;
+		myRoot = buildBalanced(slots, 0, int(slots.size()), 0);
+	}
+
+	int myCapacity;
+	double myKeyTolerance;
+	//Length of every parameter vector, 0 until the first insertion
+	arma::uword myDimension;
+	int myRoot;
+	int myNumDeadNodes;
+	std::vector<Entry> myEntries;
+	std::vector<Node> myNodes;
+	//Slots of the live entries, most recently used first
+	std::list<int> myRecency;
+	mutable std::mutex myMutex;
+};
+
+struct CachedSolveResult
+{
+	int iterations;
+	int jacobians;
+	double error;
+	bool converged;
+	bool cacheHit;
+};
+
+template <class Model, class JacobianPolicy, class LinearSolverPolicy>
+CachedSolveResult solveWithCache(SolutionCache& myCache,
+				 const arma::Col<double>& myParameters,
+				 const Model& myModel,
+				 arma::Col<double>& myGuess,
+				 const arma::Col<double>& myTargets,
+				 int myMaxIterations,
+				 double myErrorTolerance,
+				 FactorizationReusePolicy myReusePolicy,
+				 const JacobianPolicy& myJacobianPolicy,
+				 const LinearSolverPolicy& myLinearSolver)
+{
+	const arma::uword n = myGuess.n_elem;
+	CachedSolveResult result;
+	result.iterations = 0;
+	result.jacobians = 0;
+	result.converged = false;
+
+	LUFactorization factors;
+	double distance;
+	result.cacheHit = myCache.findNearest(myParameters, myGuess, factors, distance);
+	bool haveFactors = result.cacheHit and factors.isFactored();
+
+	std::valarray<double> point(n);
+	std::valarray<double> values(n);
+	arma::Col<double> targetsCalculated(n);
+	for(arma::uword i = 0; i < n; i++)
+	{
+		point[i] = myGuess[i];
+	}
+	myModel(point, values);
+	for(arma::uword i = 0; i < n; i++)
+	{
+		targetsCalculated[i] = values[i];
+	}
+	result.error = arma::norm(myTargets - targetsCalculated, 2);
+
+	//Modified Newton steps with the cached factors
+	if(haveFactors)
+	{
+		myReusePolicy.refreshed();
+		while(result.error > myErrorTolerance and result.iterations < myMaxIterations and not myReusePolicy.needsRefresh())
+		{
+			arma::Col<double> previousGuess = myGuess;
+			arma::Col<double> previousTargetsCalculated = targetsCalculated;
+			double previousError = result.error;
+			myGuess -= factors.solve(targetsCalculated - myTargets);
+
+			for(arma::uword i = 0; i < n; i++)
+			{
+				point[i] = myGuess[i];
+			}
+			myModel(point, values);
+			for(arma::uword i = 0; i < n; i++)
+			{
+				targetsCalculated[i] = values[i];
+			}
+			result.error = arma::norm(myTargets - targetsCalculated, 2);
+			result.iterations++;
+			myReusePolicy.recordStep(previousError, result.error);
+
+			//A step that made things worse is undone, with the F(x) that goes with the guess,
+			//and Newton takes over from the better guess
+			if(result.error > previousError)
+			{
+				myGuess = previousGuess;
+				targetsCalculated = previousTargetsCalculated;
+				result.error = previousError;
+				break;
+			}
+		}
+	}
+
+	bool factorsAtRoot = false;
+	bool newtonRan = false;
+	if(result.error > myErrorTolerance and result.iterations < myMaxIterations)
+	{
+		NewtonSolver<Model, JacobianPolicy, LinearSolverPolicy> solver(myModel,
+									       myMaxIterations - result.iterations,
+									       myErrorTolerance,
+									       myJacobianPolicy,
+									       myLinearSolver);
+		NewtonResult newtonResult = solver.solve(myGuess, myTargets);
+		result.iterations += newtonResult.iterations;
+		result.jacobians += newtonResult.iterations;
+		result.error = newtonResult.error;
+		if(newtonResult.iterations > 0)
+		{
+			newtonRan = true;
+			factorsAtRoot = factors.factor(solver.jacobian());
+		}
+	}
+
+	result.converged = result.error <= myErrorTolerance;
+
+	//The cached root of these very parameters already solves them: its factors are still the ones at the root
+	if(result.converged and result.cacheHit and distance == 0.0 and result.iterations == 0)
+	{
+		return result;
+	}
+
+	//Converged on the neighbour's factors alone: factor the Jacobian at the new root instead of handing those on,
+	//targetsCalculated is still F(myGuess) since NewtonSolver did not move it
+	if(result.converged and not newtonRan)
+	{
+		JacobianPolicy jacobianPolicy(myJacobianPolicy);
+		arma::Mat<double> jacobian(n, n);
+		jacobianPolicy(myModel, myGuess, targetsCalculated, jacobian);
+		result.jacobians++;
+		factorsAtRoot = factors.factor(jacobian);
+	}
+
+	if(result.converged and factorsAtRoot)
+	{
+		myCache.insert(myParameters, myGuess, factors);
+	}
+	return result;
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+####Title:
+Sparse (CSC) Jacobian for the Newton Raphson Examples
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+A dense NUMDIMENSIONS x NUMDIMENSIONS Jacobian needs 80 GB at 10^5 unknowns, even though a banded problem has only
+a handful of nonzeros per row. SparseJacobian keeps only the entries of the sparsity pattern, in compressed sparse
+column (CSC) form, the layout Armadillo's SpMat and SuperLU use:
+
+-rowIndices[k] is the row of the k-th stored entry, entries are stored column by column
+-columnPointers[j] .. columnPointers[j+1]-1 are the positions of the entries of column j
+-values[k] is the value of the k-th stored entry
+
+The pattern (rowIndices, columnPointers) never changes between Newton iterations, so it is built once; the
+Jacobian calculation writes straight into "values" at the positions the pattern gives it, without searching or
+inserting. SparseLU (sparse_lu.hpp) factors it with SuperLU and, since the pattern is fixed, does the symbolic
+analysis only for the first Jacobian.
+*/
+
+#ifndef SPARSE_JACOBIAN_HPP
+#define SPARSE_JACOBIAN_HPP
+
+#include <armadillo>
+
+class SparseJacobian
+{
+public:
+	SparseJacobian(const arma::Col<arma::uword>& rowIndices,
+		       const arma::Col<arma::uword>& columnPointers,
+		       arma::uword numRows)
+		: myRowIndices(rowIndices), myColumnPointers(columnPointers), myNumRows(numRows)
+	{
+		myValues.zeros(rowIndices.n_elem);
+	}
+
+	arma::uword numRows() const
+	{
+		return myNumRows;
+	}
+
+	arma::uword numColumns() const
+	{
+		return myColumnPointers.n_elem - 1;
+	}
+
+	arma::uword numNonzeros() const
+	{
+		return myValues.n_elem;
+	}
+
+	const arma::Col<arma::uword>& rowIndices() const
+	{
+		return myRowIndices;
+	}
+
+	const arma::Col<arma::uword>& columnPointers() const
+	{
+		return myColumnPointers;
+	}
+
+	//Filled in place by the Jacobian calculation, in the order given by the pattern
+	arma::Col<double>& values()
+	{
+		return myValues;
+	}
+
+	const arma::Col<double>& values() const
+	{
+		return myValues;
+	}
+
+	//Only meant for small problems, e.g. to print the Jacobian
+	arma::Mat<double> dense() const
+	{
+		arma::Mat<double> matrix(myNumRows, numColumns());
+		matrix.fill(0.0);
+		for(arma::uword j = 0; j < numColumns(); j++)
+		{
+			for(arma::uword k = myColumnPointers[j]; k < myColumnPointers[j + 1]; k++)
+			{
+				matrix(myRowIndices[k], j) = myValues[k];
+			}
+		}
+		return matrix;
+	}
+
+	//product = Jacobian * vector, one pass over the stored entries
+	void multiply(const arma::Col<double>& vector, arma::Col<double>& product) const
+	{
+		product.zeros(myNumRows);
+		for(arma::uword j = 0; j < numColumns(); j++)
+		{
+			for(arma::uword k = myColumnPointers[j]; k < myColumnPointers[j + 1]; k++)
+			{
+				product[myRowIndices[k]] += myValues[k]*vector[j];
+			}
+		}
+	}
+
+private:
+	arma::Col<arma::uword> myRowIndices;
+	arma::Col<arma::uword> myColumnPointers;
+	arma::uword myNumRows;
+	arma::Col<double> myValues;
+};
+
+#endif
@@ -0,0 +1,160 @@
+/*
+####Title:
+Sparse LU of the Jacobian through SuperLU, with the Symbolic Analysis Reused across Newton Iterations
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+A sparse LU factorization has two parts:
+-the symbolic analysis, which depends only on the sparsity pattern: a column ordering that limits fill-in
+ (COLAMD), the column elimination tree of the reordered matrix, and its postorder
+-the numeric factorization, which depends on the values: Pr*A*Pc = L*U with partial pivoting (the row
+ permutation Pr)
+The pattern of a SparseJacobian (sparse_jacobian.hpp) never changes between Newton iterations, so only the first
+"factor" does the symbolic analysis. It keeps the column permutation Pc and the elimination tree, and every
+later "factor" hands them back to SuperLU with options.Fact = SamePattern, which skips straight to the numeric
+factorization. The row permutation is still chosen anew every time, since the pivots depend on the values.
+arma::spsolve cannot do this, it has no way to keep SuperLU's state between calls, so SuperLU is called directly.
+
+The factors are held by SuperLU until the next "factor" or the destructor frees them, so a SparseLU is not
+copied. A SparseLU must only ever be given Jacobians with one and the same sparsity pattern.
+
+Needs the SuperLU headers and library (version 5, which added the GlobalLU_t argument of dgstrf).
+*/
+
+#ifndef SPARSE_LU_HPP
+#define SPARSE_LU_HPP
+
+#include <vector>
+#include <armadillo>
+#include <slu_ddefs.h>
+#include "sparse_jacobian.hpp"
+
+class SparseLU
+{
+public:
+	SparseLU()
+		: myIsAnalyzed(false), myHasFactors(false), myIsFactored(false)
+	{
+	}
+
+	~SparseLU()
+	{
+		destroyFactors();
+	}
+
+	//Factors the Jacobian, false if it is singular
+	//The first call also orders the columns and builds the elimination tree, later calls reuse both
+	bool factor(const SparseJacobian& jacobian)
+	{
+		const int n = int(jacobian.numColumns());
+		if(not myIsAnalyzed)
+		{
+			//SuperLU indexes with int
+			myRowIndices.assign(jacobian.rowIndices().begin(), jacobian.rowIndices().end());
+			myColumnPointers.assign(jacobian.columnPointers().begin(), jacobian.columnPointers().end());
+			myColumnPermutation.assign(n, 0);
+			myRowPermutation.assign(n, 0);
+			myEliminationTree.assign(n, 0);
+		}
+		//dgstrf allocates new factors, the old ones are freed first
+		destroyFactors();
+
+		//SuperLU only reads the values, its C interface is just not const
+		SuperMatrix matrix;
+		dCreate_CompCol_Matrix(&matrix, int(jacobian.numRows()), n, int(jacobian.numNonzeros()),
+				       const_cast<double*>(jacobian.values().memptr()), &myRowIndices[0], &myColumnPointers[0],
+				       SLU_NC, SLU_D, SLU_GE);
+
+		superlu_options_t options;
+		set_default_options(&options);
+		options.Fact = myIsAnalyzed ? SamePattern : DOFACT;
+		if(not myIsAnalyzed)
+		{
+			get_perm_c(COLAMD, &matrix, &myColumnPermutation[0]);
+		}
+
+		//A*Pc; with DOFACT this also builds the elimination tree and postorders it into Pc
+		SuperMatrix permutedMatrix;
+		sp_preorder(&options, &matrix, &myColumnPermutation[0], &myEliminationTree[0], &permutedMatrix);
+		myIsAnalyzed = true;
+
+		SuperLUStat_t statistics;
+		StatInit(&statistics);
+		int info = 0;
+		dgstrf(&options, &permutedMatrix, sp_ienv(2), sp_ienv(1), &myEliminationTree[0], NULL, 0,
+		       &myColumnPermutation[0], &myRowPermutation[0], &myL, &myU, &myGlobalLU, &statistics, &info);
+		StatFree(&statistics);
+		Destroy_CompCol_Permuted(&permutedMatrix);
+		Destroy_SuperMatrix_Store(&matrix);
+
+		//0 < info <= n: a pivot of U is exactly zero, the factors exist but cannot be solved with
+		//info > n: SuperLU ran out of memory before it made any factors
+		myHasFactors = info <= n;
+		myIsFactored = info == 0;
+		return myIsFactored;
+	}
+
+	bool isFactored() const
+	{
+		return myIsFactored;
+	}
+
+	//Solves Jacobian * solution = rightHandSide with the factors of the last "factor", false if there are none
+	bool solve(const arma::Col<double>& rightHandSide, arma::Col<double>& solution) const
+	{
+		if(not myIsFactored)
+		{
+			return false;
+		}
+
+		//dgstrs overwrites the right hand side with the solution
+		solution = rightHandSide;
+		SuperMatrix denseSolution;
+		dCreate_Dense_Matrix(&denseSolution, int(solution.n_elem), 1, solution.memptr(), int(solution.n_elem),
+				     SLU_DN, SLU_D, SLU_GE);
+
+		//dgstrs only reads the factors and permutations, its C interface is just not const
+		SuperLUStat_t statistics;
+		StatInit(&statistics);
+		int info = 0;
+		dgstrs(NOTRANS, const_cast<SuperMatrix*>(&myL), const_cast<SuperMatrix*>(&myU),
+		       const_cast<int*>(&myColumnPermutation[0]), const_cast<int*>(&myRowPermutation[0]),
+		       &denseSolution, &statistics, &info);
+		StatFree(&statistics);
+		Destroy_SuperMatrix_Store(&denseSolution);
+		return info == 0;
+	}
+
+private:
+	void destroyFactors()
+	{
+		if(myHasFactors)
+		{
+			Destroy_SuperNode_Matrix(&myL);
+			Destroy_CompCol_Matrix(&myU);
+			myHasFactors = false;
+		}
+		myIsFactored = false;
+	}
+
+	std::vector<int> myRowIndices;
+	std::vector<int> myColumnPointers;
+	//Symbolic analysis, kept from the first factorization
+	std::vector<int> myColumnPermutation;
+	std::vector<int> myEliminationTree;
+	//Numeric factorization, redone by every "factor"
+	std::vector<int> myRowPermutation;
+	SuperMatrix myL;
+	SuperMatrix myU;
+	GlobalLU_t myGlobalLU;
+	bool myIsAnalyzed;
+	bool myHasFactors;
+	bool myIsFactored;
+
+	SparseLU(const SparseLU&);
+	SparseLU& operator=(const SparseLU&);
+};
+
+#endif
@@ -0,0 +1,271 @@
+/*
+####Title:
+Banded and Block-Diagonal Solvers for Structured Jacobians
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+Many models couple each unknown only to a few neighbours, which makes the Jacobian banded or block diagonal.
+"detectJacobianStructure" reads both properties off the sparsity pattern of a SparseJacobian (sparse_jacobian.hpp):
+-the lower and upper bandwidths, the largest distance below and above the diagonal of any stored entry
+-the diagonal blocks: a block boundary b is a position where no stored entry couples an unknown before b
+ with one from b on
+
+BandedLU stores only the band, in the LAPACK band layout used by dgbsv: column j of the Jacobian becomes
+column j of a (2*lowerBandwidth + upperBandwidth + 1) x NUMDIMENSIONS array, the extra lowerBandwidth rows
+holding the fill-in that row interchanges create. "factor" is the partial pivoting elimination of dgbtf2 and
+"solve" the two band triangular solves of dgbtrs, so memory is O(N*bandwidth) and the solve time
+O(N*lowerBandwidth*(lowerBandwidth + upperBandwidth)) instead of O(N^2) and O(N^3). Bandwidths narrower than the
+detected ones would solve a different matrix, so "factor" fails on any nonzero outside the band.
+
+BlockDiagonalLU factors every diagonal block independently (LUFactorization, lu_factorization.hpp) and solves them
+one after another. With the detected blocks no entry lies outside of them, so the result is exact; blocks forced
+by the caller that cut through a coupling drop the entries outside of them, and the result is then only approximate.
+*/
+
+#ifndef STRUCTURED_SOLVERS_HPP
+#define STRUCTURED_SOLVERS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <armadillo>
+#include "lu_factorization.hpp"
+#include "sparse_jacobian.hpp"
+
+struct JacobianStructure
+{
+	arma::uword lowerBandwidth;
+	arma::uword upperBandwidth;
+	//First unknown of every diagonal block, followed by the number of unknowns
+	std::vector<arma::uword> blockStarts;
+};
+
+inline JacobianStructure detectJacobianStructure(const SparseJacobian& myJacobian)
+{
+	const arma::Col<arma::uword>& rowIndices = myJacobian.rowIndices();
+	const arma::Col<arma::uword>& columnPointers = myJacobian.columnPointers();
+	const arma::uword n = myJacobian.numColumns();
+
+	JacobianStructure structure;
+	structure.lowerBandwidth = 0;
+	structure.upperBandwidth = 0;
+
+	//farthestPartner[i] is the largest unknown coupled to unknown i by an entry with i the smaller of row and column
+	std::vector<arma::uword> farthestPartner(n);
+	for(arma::uword i = 0; i < n; i++)
+	{
+		farthestPartner[i] = i;
+	}
+	for(arma::uword j = 0; j < n; j++)
+	{
+		for(arma::uword k = columnPointers[j]; k < columnPointers[j + 1]; k++)
+		{
+			arma::uword i = rowIndices[k];
+			if(i > j)
+			{
+				structure.lowerBandwidth = std::max(structure.lowerBandwidth, i - j);
+			}
+			else
+			{
+				structure.upperBandwidth = std::max(structure.upperBandwidth, j - i);
+			}
+			arma::uword first = std::min(i, j);
+			farthestPartner[first] = std::max(farthestPartner[first], std::max(i, j));
+		}
+	}
+
+	//A block ends where nothing before the boundary reaches past it
+	structure.blockStarts.push_back(0);
+	arma::uword reach = 0;
+	for(arma::uword i = 0; i + 1 < n; i++)
+	{
+		reach = std::max(reach, farthestPartner[i]);
+		if(reach <= i)
+		{
+			structure.blockStarts.push_back(i + 1);
+		}
+	}
+	structure.blockStarts.push_back(n);
+
+	return structure;
+}
+
+class BandedLU
+{
+public:
+	BandedLU(arma::uword lowerBandwidth, arma::uword upperBandwidth)
+		: myLowerBandwidth(lowerBandwidth), myUpperBandwidth(upperBandwidth), mySize(0)
+	{
+	}
+
+	//Copies the band of the Jacobian into band storage and factors it
+	//False if it is singular, or if a nonzero lies outside the band, which would otherwise be dropped silently
+	bool factor(const SparseJacobian& jacobian)
+	{
+		const arma::Col<arma::uword>& rowIndices = jacobian.rowIndices();
+		const arma::Col<arma::uword>& columnPointers = jacobian.columnPointers();
+		mySize = jacobian.numColumns();
+		const arma::uword rows = 2*myLowerBandwidth + myUpperBandwidth + 1;
+		myBand.zeros(rows, mySize);
+		myPivots.assign(mySize, 0);
+
+		for(arma::uword j = 0; j < mySize; j++)
+		{
+			for(arma::uword k = columnPointers[j]; k < columnPointers[j + 1]; k++)
+			{
+				arma::uword i = rowIndices[k];
+				if(i + myUpperBandwidth >= j and i <= j + myLowerBandwidth)
+				{
+					at(i, j) = jacobian.values()[k];
+				}
+				else if(jacobian.values()[k] != 0.0)
+				{
+					return false;
+				}
+			}
+		}
+
+		//dgbtf2: partial pivoting within the lower band, the upper band grows by at most lowerBandwidth
+		arma::uword lastColumn = 0;
+		for(arma::uword j = 0; j < mySize; j++)
+		{
+			arma::uword belowDiagonal = std::min(myLowerBandwidth, mySize - 1 - j);
+			arma::uword pivot = j;
+			for(arma::uword i = j + 1; i <= j + belowDiagonal; i++)
+			{
+				if(std::fabs(at(i, j)) > std::fabs(at(pivot, j)))
+				{
+					pivot = i;
+				}
+			}
+			myPivots[j] = pivot;
+			if(at(pivot, j) == 0.0)
+			{
+				return false;
+			}
+
+			lastColumn = std::max(lastColumn, std::min(pivot + myUpperBandwidth, mySize - 1));
+			if(pivot != j)
+			{
+				for(arma::uword c = j; c <= lastColumn; c++)
+				{
+					std::swap(at(j, c), at(pivot, c));
+				}
+			}
+
+			for(arma::uword i = j + 1; i <= j + belowDiagonal; i++)
+			{
+				at(i, j) /= at(j, j);
+				for(arma::uword c = j + 1; c <= lastColumn; c++)
+				{
+					at(i, c) -= at(i, j)*at(j, c);
+				}
+			}
+		}
+		return true;
+	}
+
+	void solve(const arma::Col<double>& rightHandSide, arma::Col<double>& solution) const
+	{
+		solution = rightHandSide;
+		const arma::uword bandAboveDiagonal = myLowerBandwidth + myUpperBandwidth;
+
+		//L: the row interchanges and unit lower band in the order they were made
+		for(arma::uword j = 0; j < mySize; j++)
+		{
+			std::swap(solution[j], solution[myPivots[j]]);
+			arma::uword belowDiagonal = std::min(myLowerBandwidth, mySize - 1 - j);
+			for(arma::uword i = j + 1; i <= j + belowDiagonal; i++)
+			{
+				solution[i] -= at(i, j)*solution[j];
+			}
+		}
+
+		//U: upper band of width lowerBandwidth + upperBandwidth
+		for(arma::uword j = mySize; j-- > 0; )
+		{
+			solution[j] /= at(j, j);
+			arma::uword first = (j > bandAboveDiagonal) ? j - bandAboveDiagonal : 0;
+			for(arma::uword i = first; i < j; i++)
+			{
+				solution[i] -= at(i, j)*solution[j];
+			}
+		}
+	}
+
+private:
+	//Entry (i, j) of the matrix in band storage
+	double& at(arma::uword i, arma::uword j)
+	{
+		return myBand(myLowerBandwidth + myUpperBandwidth + i - j, j);
+	}
+
+	double at(arma::uword i, arma::uword j) const
+	{
+		return myBand(myLowerBandwidth + myUpperBandwidth + i - j, j);
+	}
+
+	arma::uword myLowerBandwidth;
+	arma::uword myUpperBandwidth;
+	arma::uword mySize;
+	arma::Mat<double> myBand;
+	std::vector<arma::uword> myPivots;
+};
+
+class BlockDiagonalLU
+{
+public:
+	explicit BlockDiagonalLU(const std::vector<arma::uword>& blockStarts)
+		: myBlockStarts(blockStarts), myBlocks(blockStarts.size() - 1)
+	{
+	}
+
+	//Factors every diagonal block on its own, false if one of them is singular
+	bool factor(const SparseJacobian& jacobian)
+	{
+		const arma::Col<arma::uword>& rowIndices = jacobian.rowIndices();
+		const arma::Col<arma::uword>& columnPointers = jacobian.columnPointers();
+		for(arma::uword b = 0; b < myBlocks.size(); b++)
+		{
+			arma::uword first = myBlockStarts[b];
+			arma::uword size = myBlockStarts[b + 1] - first;
+			arma::Mat<double> block(size, size);
+			block.fill(0.0);
+			for(arma::uword j = first; j < first + size; j++)
+			{
+				//Entries outside of the block, couplings that a forced block size cuts through, are dropped
+				for(arma::uword k = columnPointers[j]; k < columnPointers[j + 1]; k++)
+				{
+					if(rowIndices[k] >= first and rowIndices[k] < first + size)
+					{
+						block(rowIndices[k] - first, j - first) = jacobian.values()[k];
+					}
+				}
+			}
+			if(not myBlocks[b].factor(block))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void solve(const arma::Col<double>& rightHandSide, arma::Col<double>& solution) const
+	{
+		solution.set_size(rightHandSide.n_elem);
+		for(arma::uword b = 0; b < myBlocks.size(); b++)
+		{
+			arma::uword first = myBlockStarts[b];
+			arma::uword last = myBlockStarts[b + 1] - 1;
+			solution.subvec(first, last) = myBlocks[b].solve(rightHandSide.subvec(first, last));
+		}
+	}
+
+private:
+	std::vector<arma::uword> myBlockStarts;
+	std::vector<LUFactorization> myBlocks;
+};
+
+#endif
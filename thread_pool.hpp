@@ -0,0 +1,254 @@
+/*
+####Title:
+Reusable Thread Pool for the Newton Raphson Examples
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+The worker threads are started once and then reused for every Jacobian, so the cost of creating threads
+is not paid on every Newton iteration.
+
+"parallelFor" hands out the task numbers 0 ... numTasks-1 to the workers one at a time and returns once all of
+them are done. The task is called as task(taskNumber, workerNumber); the worker number is always in
+0 ... size()-1, which lets the caller keep one private buffer per worker (a perturbed copy of the guess,
+a place for the perturbed model evaluation) instead of sharing one between threads.
+
+"parallelForWorkStealing" runs the same kind of loop with a work-stealing schedule, for many tasks of very
+different cost (e.g. Newton solves that converge in very different iteration counts). Every worker starts with
+its own contiguous range of task numbers and takes them from the front; a worker whose range has run out steals
+the back half of the largest range left, so no worker idles while work remains, and the workers do not all
+contend for one shared counter.
+
+Requires C++11 (compile with -std=c++11 -pthread).
+*/
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+	explicit ThreadPool(int numThreads)
+		: myRanges(std::max(numThreads, 1)), myTask(0), myNumTasks(0), myNextTask(0), myWorkStealing(false),
+		  myWorkersBusy(0), myGeneration(0), myStopping(false)
+	{
+		if(numThreads < 1)
+		{
+			numThreads = 1;
+		}
+		for(int w = 0; w < numThreads; w++)
+		{
+			myWorkers.push_back(std::thread(&ThreadPool::workerLoop, this, w));
+		}
+	}
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(myMutex);
+			myStopping = true;
+		}
+		myWorkAvailable.notify_all();
+		for(size_t w = 0; w < myWorkers.size(); w++)
+		{
+			myWorkers[w].join();
+		}
+	}
+
+	int size() const
+	{
+		return int(myWorkers.size());
+	}
+
+	//Run task(taskNumber, workerNumber) for every taskNumber in 0 ... numTasks-1 and wait for all of them
+	void parallelFor(int numTasks, const std::function<void(int, int)>& task)
+	{
+		run(numTasks, task, false);
+	}
+
+	//The same as parallelFor, with task numbers split into one range per worker and stolen between them
+	void parallelForWorkStealing(int numTasks, const std::function<void(int, int)>& task)
+	{
+		run(numTasks, task, true);
+	}
+
+private:
+	//Task numbers begin ... end-1 still to be run, the owner takes from the front and thieves from the back
+	struct TaskRange
+	{
+		std::mutex mutex;
+		int begin;
+		int end;
+	};
+
+	void run(int numTasks, const std::function<void(int, int)>& task, bool workStealing)
+	{
+		if(numTasks <= 0)
+		{
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(myMutex);
+		myTask = &task;
+		myNumTasks = numTasks;
+		myNextTask = 0;
+		myWorkStealing = workStealing;
+		if(workStealing)
+		{
+			int numWorkers = int(myWorkers.size());
+			for(int w = 0; w < numWorkers; w++)
+			{
+				std::lock_guard<std::mutex> rangeLock(myRanges[w].mutex);
+				myRanges[w].begin = int((long(numTasks)*w)/numWorkers);
+				myRanges[w].end = int((long(numTasks)*(w + 1))/numWorkers);
+			}
+		}
+		myWorkersBusy = int(myWorkers.size());
+		myGeneration++;
+		myWorkAvailable.notify_all();
+
+		//every worker checks in once it finds no more tasks, so the task object outlives all uses of it
+		myWorkDone.wait(lock, [this]() { return myWorkersBusy == 0; });
+		myTask = 0;
+	}
+
+	//Next task of the worker's own range, -1 once it is empty
+	int takeTask(int workerNumber)
+	{
+		TaskRange& range = myRanges[workerNumber];
+		std::lock_guard<std::mutex> lock(range.mutex);
+		if(range.begin < range.end)
+		{
+			return range.begin++;
+		}
+		return -1;
+	}
+
+	//Moves the back half of the largest remaining range to the worker's own range, false if nothing is left
+	bool stealTasks(int workerNumber)
+	{
+		int numWorkers = int(myWorkers.size());
+		while(true)
+		{
+			int victim = -1;
+			int mostRemaining = 0;
+			for(int w = 0; w < numWorkers; w++)
+			{
+				std::lock_guard<std::mutex> lock(myRanges[w].mutex);
+				if(myRanges[w].end - myRanges[w].begin > mostRemaining)
+				{
+					mostRemaining = myRanges[w].end - myRanges[w].begin;
+					victim = w;
+				}
+			}
+			if(victim < 0)
+			{
+				return false;
+			}
+
+			int stolenBegin = 0;
+			int stolenEnd = 0;
+			{
+				std::lock_guard<std::mutex> lock(myRanges[victim].mutex);
+				int remaining = myRanges[victim].end - myRanges[victim].begin;
+				if(remaining <= 0)
+				{
+					//The owner or another thief got there first, look again
+					continue;
+				}
+				stolenEnd = myRanges[victim].end;
+				stolenBegin = stolenEnd - (remaining + 1)/2;
+				myRanges[victim].end = stolenBegin;
+			}
+
+			std::lock_guard<std::mutex> lock(myRanges[workerNumber].mutex);
+			myRanges[workerNumber].begin = stolenBegin;
+			myRanges[workerNumber].end = stolenEnd;
+			return true;
+		}
+	}
+
+	void workerLoop(int workerNumber)
+	{
+		unsigned long seenGeneration = 0;
+		while(true)
+		{
+			const std::function<void(int, int)>* task = 0;
+			int numTasks = 0;
+			bool workStealing = false;
+			{
+				std::unique_lock<std::mutex> lock(myMutex);
+				myWorkAvailable.wait(lock, [&]() { return myStopping or myGeneration != seenGeneration; });
+				if(myStopping)
+				{
+					return;
+				}
+				seenGeneration = myGeneration;
+				task = myTask;
+				numTasks = myNumTasks;
+				workStealing = myWorkStealing;
+			}
+
+			if(workStealing)
+			{
+				while(true)
+				{
+					int t = takeTask(workerNumber);
+					if(t < 0)
+					{
+						if(not stealTasks(workerNumber))
+						{
+							break;
+						}
+						continue;
+					}
+					(*task)(t, workerNumber);
+				}
+			}
+			else
+			{
+				//tasks are claimed one at a time so uneven tasks still balance across the workers
+				for(int t = myNextTask++; t < numTasks; t = myNextTask++)
+				{
+					(*task)(t, workerNumber);
+				}
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(myMutex);
+				myWorkersBusy--;
+				if(myWorkersBusy == 0)
+				{
+					myWorkDone.notify_one();
+				}
+			}
+		}
+	}
+
+	std::vector<std::thread> myWorkers;
+	std::vector<TaskRange> myRanges;
+	std::mutex myMutex;
+	std::condition_variable myWorkAvailable;
+	std::condition_variable myWorkDone;
+	const std::function<void(int, int)>* myTask;
+	int myNumTasks;
+	std::atomic<int> myNextTask;
+	bool myWorkStealing;
+	int myWorkersBusy;
+	unsigned long myGeneration;
+	bool myStopping;
+
+	ThreadPool(const ThreadPool&);
+	ThreadPool& operator=(const ThreadPool&);
+};
+
+#endif
@@ -0,0 +1,128 @@
+/*
+####Title:
+Trust-Region Dogleg Step for the Newton Raphson Examples
+
+####Date:
+16 Oct. 2026
+
+####Notes:
+A trust region limits the Newton step to a radius around the current guess in which the linear model
+F(x + p) ~= F(x) + J*p is trusted. With r = F(x) - targets, the model of the merit function 0.5*||r||^2 is
+m(p) = 0.5*||r + J*p||^2, and the Powell dogleg step approximately minimizes it within the radius:
+
+-the Newton step pN solves J*pN = -r; if it fits inside the radius it is taken as is
+-otherwise the Cauchy point pC = -(||g||^2/||J*g||^2)*g minimizes m along the steepest descent direction g = J^T*r;
+ if even that lies outside, the steepest descent step is cut at the radius
+-otherwise the step follows the segment from pC towards pN up to the radius
+
+After the model has been evaluated at x + p, the ratio of the actual to the predicted reduction,
+(0.5*||r||^2 - 0.5*||r_new||^2) / (m(0) - m(p)), decides both whether the step is kept and the next radius:
+below 0.25 the radius shrinks to a quarter of the step, unless the step had zero length, above 0.75 with the step
+at the boundary it doubles (up to maxRadius). A rejected step leaves the guess where it was, and the same Jacobian is used again with
+the smaller radius, so a rejection costs one model evaluation instead of a new Jacobian.
+*/
+
+#ifndef TRUST_REGION_HPP
+#define TRUST_REGION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <armadillo>
+
+class DoglegTrustRegion
+{
+public:
+	DoglegTrustRegion(double initialRadius, double maxRadius)
+		: myRadius(initialRadius), myMaxRadius(maxRadius), myStepLength(0.0), myPredictedReduction(0.0),
+		  myLastStepAccepted(true)
+	{
+	}
+
+	double radius() const
+	{
+		return myRadius;
+	}
+
+	//A rejected step is retried with the Jacobian it was computed from
+	bool needsJacobian() const
+	{
+		return myLastStepAccepted;
+	}
+
+	//Dogleg step p for J*p ~= -residual with ||p|| <= radius, where residual = F(x) - targets
+	arma::Col<double> step(const arma::Mat<double>& jacobian, const arma::Col<double>& residual)
+	{
+		arma::Col<double> gradient = jacobian.t()*residual;
+		double gradientNorm = arma::norm(gradient, 2);
+
+		arma::Col<double> newtonStep;
+		bool newtonStepExists = arma::solve(newtonStep, jacobian, -residual);
+
+		arma::Col<double> doglegStep;
+		if(newtonStepExists and arma::norm(newtonStep, 2) <= myRadius)
+		{
+			doglegStep = newtonStep;
+		}
+		else if(gradientNorm == 0.0)
+		{
+			//No descent direction, the step is empty and will be rejected
+			doglegStep.zeros(residual.n_elem);
+		}
+		else
+		{
+			arma::Col<double> jacobianTimesGradient = jacobian*gradient;
+			double curvature = arma::dot(jacobianTimesGradient, jacobianTimesGradient);
+			arma::Col<double> cauchyStep = -(gradientNorm*gradientNorm/curvature)*gradient;
+			double cauchyNorm = arma::norm(cauchyStep, 2);
+
+			if(not newtonStepExists or cauchyNorm >= myRadius)
+			{
+				doglegStep = -(myRadius/gradientNorm)*gradient;
+			}
+			else
+			{
+				//||cauchyStep + tau*difference|| = radius, the positive root of a quadratic in tau
+				arma::Col<double> difference = newtonStep - cauchyStep;
+				double a = arma::dot(difference, difference);
+				double b = 2.0*arma::dot(cauchyStep, difference);
+				double c = cauchyNorm*cauchyNorm - myRadius*myRadius;
+				double tau = (-b + std::sqrt(b*b - 4.0*a*c))/(2.0*a);
+				doglegStep = cauchyStep + tau*difference;
+			}
+		}
+
+		myStepLength = arma::norm(doglegStep, 2);
+		arma::Col<double> predictedResidual = residual + jacobian*doglegStep;
+		myPredictedReduction = 0.5*arma::dot(residual, residual) - 0.5*arma::dot(predictedResidual, predictedResidual);
+		return doglegStep;
+	}
+
+	//Errors are the L2 norms of the residual before and after the step; true if the step is kept
+	bool update(double previousError, double error)
+	{
+		double actualReduction = 0.5*previousError*previousError - 0.5*error*error;
+		double ratio = (myPredictedReduction > 0.0) ? actualReduction/myPredictedReduction : -1.0;
+
+		//A zero-length step (zero gradient or Newton step) says nothing about the model, a radius of 0 could never grow
+		if(ratio < 0.25 and myStepLength > 0.0)
+		{
+			myRadius = 0.25*myStepLength;
+		}
+		else if(ratio > 0.75 and myStepLength >= 0.99*myRadius)
+		{
+			myRadius = std::min(2.0*myRadius, myMaxRadius);
+		}
+
+		myLastStepAccepted = ratio > 1.0E-4;
+		return myLastStepAccepted;
+	}
+
+private:
+	double myRadius;
+	double myMaxRadius;
+	double myStepLength;
+	double myPredictedReduction;
+	bool myLastStepAccepted;
+};
+
+#endif